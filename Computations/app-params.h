@@ -2,12 +2,26 @@
 
 #include <core.h>
 
+#include <string>
+
 struct AppParams
 {
 	uint xSplit{};
 	uint ySplit{};
+	uint zSplit{};           // 3d systems only
 	uint totalUpdates{};
 	uint itersPerUpdate{};
 	uint gridX{};
 	uint gridY{};
+	uint warmStartLevels{};  // coarse levels of the nested iteration, 0 - cold start
+	uint warmStartUpdates{}; // updates on each coarse level
+	uint channels{};         // problems packed into one handle
+	std::string shape;       // box, l_shape or perforated
+	std::string coefficient; // constant, layered or checker
+	std::string boundary;    // dirichlet, neumann, robin or mixed
+	std::string time;        // steady, backward_euler or crank_nicolson
+	f32 timeStep{};          // implicit schemes only
+	uint stepUpdates{};      // updates of the system per implicit time step
+	std::string convection;  // none, central or upwind
+	f32 velocity{};          // b = (velocity, velocity), convective problems only
 };
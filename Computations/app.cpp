@@ -12,8 +12,12 @@
 
 #include <dirichlet/dirichlet-proxy.h>
 #include <dirichlet/dirichlet_handle.h>
+#include <dirichlet/warm_start.h>
+#include <dirichlet/heat.h>
 #include <dirichlet/dirichlet_dataaabb2d.h>
 #include <dirichlet/dirichlet_domainaabb2d.h>
+#include <dirichlet/dirichlet_dataaabb3d.h>
+#include <dirichlet/dirichlet_domainaabb3d.h>
 #include <dirichlet/dirichlet_cfg.h>
 
 #include <fs.h>
@@ -28,8 +32,10 @@
 #include <shader-storage.h>
 #include <program-storage.h>
 
+#include <cmath>
 #include <thread>
 #include <string>
+#include <vector>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
@@ -56,17 +62,26 @@ namespace app
 				m_elapsedMean.push_back(t);
 			}
 
+			void trackResidual(f32 r)
+			{
+				m_residual.push_back(r);
+			}
+
 			json toJson() const
 			{
 				json result;
 				result["elapsed"] = m_elapsed;
 				//result["elapsed_mean"] = m_elapsedMean;
+				if (!m_residual.empty()) {
+					result["residual"] = m_residual;
+				}
 				return result;
 			}
 
 		private:
 			std::vector<GLint64> m_elapsed;
 			std::vector<f64> m_elapsedMean;
+			std::vector<f32> m_residual;
 		};
 
 		struct RequiredModules
@@ -95,30 +110,199 @@ namespace app
 
 		struct InitData
 		{
-			static InitData get(uint xSplit, uint ySplit)
+			// region of the domain embedded in [-1, 1] x [-1, 1], empty for the whole box
+			static Region2D get_region(const std::string& shape)
+			{
+				if (shape == "l_shape") {
+					return [] (f32 x, f32 y)
+					{
+						return x <= 0.0f || y <= 0.0f;
+					};
+				}
+				if (shape == "perforated") {
+					// 4 x 4 holes
+					return [] (f32 x, f32 y)
+					{
+						for (i32 i = 0; i < 4; i++) {
+							for (i32 j = 0; j < 4; j++) {
+								f32 dx = x - (-0.75f + 0.5f * j);
+								f32 dy = y - (-0.75f + 0.5f * i);
+								if (dx * dx + dy * dy < 0.15f * 0.15f) {
+									return false;
+								}
+							}
+						}
+						return true;
+					};
+				}
+				return {};
+			}
+
+			// k of div(k grad u) = f, empty for k = 1
+			static Function2D get_coefficient(const std::string& coefficient)
+			{
+				// two materials, contrast 1 : 10
+				if (coefficient == "layered") {
+					return [] (f32 /*x*/, f32 y) -> f32
+					{
+						return y < 0.0f ? 1.0f : 10.0f;
+					};
+				}
+				if (coefficient == "checker") {
+					return [] (f32 x, f32 y) -> f32
+					{
+						i32 cx = (i32)std::floor(4.0f * x);
+						i32 cy = (i32)std::floor(4.0f * y);
+						return ((cx + cy) & 0x1) ? 10.0f : 1.0f;
+					};
+				}
+				return {};
+			}
+
+			// edges of the box, all dirichlet by default
+			static BoundaryConditions get_boundary(const std::string& boundary)
+			{
+				BoundaryConditions conditions;
+				if (boundary == "neumann") {
+					conditions.type[BoundaryConditions::left]  = BoundaryType::Neumann;
+					conditions.type[BoundaryConditions::right] = BoundaryType::Neumann;
+				}
+				if (boundary == "robin") {
+					conditions.type[BoundaryConditions::left]  = BoundaryType::Robin;
+					conditions.type[BoundaryConditions::right] = BoundaryType::Robin;
+					conditions.a[BoundaryConditions::left]  = 1.0f;
+					conditions.a[BoundaryConditions::right] = 1.0f;
+				}
+				// top edge keeps the problem well-posed, corners of neumann and robin edges are unknowns
+				if (boundary == "mixed") {
+					conditions.type[BoundaryConditions::left]   = BoundaryType::Neumann;
+					conditions.type[BoundaryConditions::right]  = BoundaryType::Robin;
+					conditions.type[BoundaryConditions::bottom] = BoundaryType::Robin;
+					conditions.a[BoundaryConditions::right]  = 2.0f;
+					conditions.a[BoundaryConditions::bottom] = 1.0f;
+				}
+				return conditions;
+			}
+
+			// b = (velocity, velocity), zero for the poisson problem
+			static Convection get_convection(const std::string& convection, f32 velocity)
+			{
+				Convection flow;
+				if (convection != "none") {
+					flow.b[0] = velocity;
+					flow.b[1] = velocity;
+				}
+				return flow;
+			}
+
+			// channels > 1 : problems with boundary and f scaled by 1, 2, ... are packed into channels
+			// u = exp(-x^2 - y^2) has du/dn = -2u on every edge of the box, so g = (a - 2)u on neumann and robin edges
+			// convection term b * grad(u) = -2(b_x x + b_y y)u is added to f of convective problems
+			static InitData get(uint xSplit, uint ySplit, uint channels, const std::string& shape, const std::string& coefficient, const std::string& boundaryConditions,
+								const std::string& convection, f32 velocity)
 			{
 				auto boundary = [] (f32 x, f32 y) -> f32
 				{
 					return std::exp(-x * x - y * y);
 				};
 
-				auto f = [] (f32 x, f32 y) -> f32
+				Convection flow = get_convection(convection, velocity);
+				auto f = [flow] (f32 x, f32 y) -> f32
 				{
 					f32 xxpyy = x * x + y * y;
-					return 4.0 * (xxpyy - 1) * std::exp(-xxpyy);
+					return (4.0 * (xxpyy - 1) - 2.0 * (flow.b[0] * x + flow.b[1] * y)) * std::exp(-xxpyy);
 				};
 
 				InitData initData;
-				initData.domain = DomainAabb2D::create_domain(-1.0, 1.0, -1.0, 1.0, xSplit, ySplit);
-				initData.data   = DataAabb2D::create_data(initData.domain, boundary, f);
+				initData.boundary = boundary;
+				initData.f        = f;
+				initData.domain   = DomainAabb2D::create_domain(-1.0, 1.0, -1.0, 1.0, xSplit, ySplit);
+				initData.region   = get_region(shape);
+				initData.k        = get_coefficient(coefficient);
+				initData.edges    = get_boundary(boundaryConditions);
+				initData.flow     = flow;
+
+				auto createData = [&] (const Function2D& problemBoundary, const Function2D& problemF)
+				{
+					DataAabb2D data = (initData.region
+						? DataAabb2D::create_masked_data(initData.domain, problemBoundary, problemF, initData.region)
+						: DataAabb2D::create_data(initData.domain, problemBoundary, problemF));
+					if (initData.k) {
+						DataAabb2D::set_coefficient(data, initData.domain, initData.k);
+					}
+					if (!initData.edges.dirichlet()) {
+						auto flux = [&] (i32 edge, f32 x, f32 y) -> f32
+						{
+							return (initData.edges.a[edge] - 2.0f) * problemBoundary(x, y);
+						};
+						DataAabb2D::set_boundary(data, initData.domain, initData.edges, problemF, flux);
+					}
+					data.convection = initData.flow;
+					return data;
+				};
+
+				initData.data = createData(boundary, f);
+				if (channels > 1) {
+					std::vector<DataAabb2D> problems;
+					for (uint c = 0; c < channels; c++) {
+						f32 scale = c + 1;
+						problems.push_back(createData(
+							[=] (f32 x, f32 y) { return scale * boundary(x, y); },
+							[=] (f32 x, f32 y) { return scale * f(x, y); }));
+					}
+					initData.data = DataAabb2D::pack_data(initData.domain, problems.data(), (i32)problems.size());
+				}
 				return initData;
 			}
 
+			Function2D boundary;
+			Function2D f;
+			Region2D region;
+			Function2D k;
+			BoundaryConditions edges;
+			Convection flow;
 			DomainAabb2D domain;
 			DataAabb2D data;
 		};
 
 
+		struct InitData3D
+		{
+			static InitData3D get(uint xSplit, uint ySplit, uint zSplit)
+			{
+				auto boundary = [] (f32 x, f32 y, f32 z) -> f32
+				{
+					return std::exp(-x * x - y * y - z * z);
+				};
+
+				auto f = [] (f32 x, f32 y, f32 z) -> f32
+				{
+					f32 rr = x * x + y * y + z * z;
+					return (4.0 * rr - 6.0) * std::exp(-rr);
+				};
+
+				InitData3D initData;
+				initData.domain = dir3d::DomainAabb3D::create_domain(-1.0, 1.0, -1.0, 1.0, -1.0, 1.0, xSplit, ySplit, zSplit);
+				initData.data   = dir3d::DataAabb3D::create_data(initData.domain, boundary, f);
+				return initData;
+			}
+
+			dir3d::DomainAabb3D domain;
+			dir3d::DataAabb3D data;
+		};
+
+		// systems of 2d and 3d problems share controls module, proxies differ only by problem description
+		template<class Func>
+		void visit_proxy(Module& module, Func&& func)
+		{
+			if (module.stores<dir3d::Proxy>()) {
+				func(module.get<dir3d::Proxy>());
+			} else {
+				func(module.get<Proxy>());
+			}
+		}
+
+
 		class AppImpl
 		{
 		public:
@@ -136,7 +320,19 @@ namespace app
 
 				uint updates = requiredModules.app->get<AppParams>().totalUpdates;
 
-				auto handles = createHandles(appParams.xSplit, appParams.ySplit, requiredModules.dirichletProxy);
+				// implicit schemes make one time step of the heat equation per update, all steps of a system share one handle
+				bool implicit = (appParams.time != "steady");
+				std::vector<SmartHandle> handles;
+				std::vector<ImplicitHeat> heats;
+				if (implicit) {
+					heats = createHeats(appParams, requiredModules.dirichletProxy, requiredModules.programStorage);
+				} else {
+					handles = createHandles(appParams, requiredModules.dirichletProxy, requiredModules.programStorage);
+				}
+				auto getHandle = [&] (uint index) -> const SmartHandle&
+				{
+					return implicit ? heats[index].handle() : handles[index];
+				};
 
 				printProxyOrder(requiredModules.dirichletProxy);
 
@@ -151,24 +347,48 @@ namespace app
 					glClearColor(0.5, 0.5, 0.5, 1.0);
 					glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+					uint proxyIndex = 0;
 					for (auto& [name, ptr] : *requiredModules.dirichletProxy) {
 						auto& tracker = trackers[name];
 
-						auto& proxy = ptr->get<Proxy>();
-						proxy.update();
-						tracker.trackElapsed(proxy.elapsed());
-						tracker.trackElapsedMean(proxy.elapsedMean());
+						// elapsed of a time step is the sum over all of its updates
+						if (implicit) {
+							auto& heat = heats[proxyIndex++];
+							if (!heat.step(ptr->get<Proxy>())) {
+								throw std::runtime_error("System " + name + " failed to create implicit time step.");
+							}
+							tracker.trackElapsed(heat.elapsed());
+							continue;
+						}
+
+						visit_proxy(*ptr, [&] (auto& proxy)
+						{
+							proxy.update();
+							tracker.trackElapsed(proxy.elapsed());
+							tracker.trackElapsedMean(proxy.elapsedMean());
+						});
 					}
 
 					grid.setup();
 					{
-						uint index = 0;
-						for (auto& handle : handles) {
-							grid.render(handle.texture(), index++);
+						uint count = (uint)(implicit ? heats.size() : handles.size());
+						for (uint index = 0; index < count; index++) {
+							grid.render(getHandle(index).texture(), index);
 						}
 					}
 				}
 
+				// residual is read back once, after all updates
+				{
+					uint index = 0;
+					for (auto& [name, ptr] : *requiredModules.dirichletProxy) {
+						visit_proxy(*ptr, [&] (auto& proxy)
+						{
+							trackers[name].trackResidual(proxy.residual(getHandle(index++).handle()));
+						});
+					}
+				}
+
 				json data;
 				data["data"] = createTrackerOutput(trackers.begin(), trackers.end());
 				data["meta"] = createMetadata(requiredModules.metainfo);
@@ -185,18 +405,106 @@ namespace app
 				std::cout << "\n";
 			}
 
-			std::vector<SmartHandle> createHandles(uint xSplit, uint ySplit, ModulePtr proxies)
+			// warm start solves coarse problems with the system itself, so its data is created per system
+			std::vector<SmartHandle> createHandles(const AppParams& appParams, ModulePtr proxies, ModulePtr programs)
 			{
-				auto initData = InitData::get(xSplit, ySplit);
+				auto initData = InitData::get(appParams.xSplit, appParams.ySplit, appParams.channels, appParams.shape, appParams.coefficient, appParams.boundary, appParams.convection, appParams.velocity);
+
+				WarmStart warmStart{(i32)appParams.warmStartLevels, (i32)appParams.warmStartUpdates, {1}};
+				gl::Id prolongateProgram = gl::null;
+				if (warmStart.levels > 0) {
+					if (appParams.channels > 1) {
+						throw std::runtime_error("Warm start of packed problems is not supported.");
+					}
+					if (initData.region) {
+						throw std::runtime_error("Warm start of masked domains is not supported.");
+					}
+					if (initData.k) {
+						throw std::runtime_error("Warm start of variable coefficient problems is not supported.");
+					}
+					if (!initData.edges.dirichlet()) {
+						throw std::runtime_error("Warm start of problems with neumann and robin edges is not supported.");
+					}
+					if (!initData.flow.none()) {
+						throw std::runtime_error("Warm start of convective problems is not supported.");
+					}
+
+					auto& programStorage = programs->get<ProgramStorage>();
+					if (!programStorage.has("prolongate")) {
+						throw std::runtime_error("Failed to obtain \"prolongate\" program.");
+					}
+					prolongateProgram = programStorage.find("prolongate")->second.program.id;
+				}
+
+				// 3d problem is created on demand, it supports none of the 2d problem options
+				std::unique_ptr<InitData3D> initData3D;
+				auto getInitData3D = [&] () -> InitData3D&
+				{
+					if (!initData3D) {
+						if (appParams.channels > 1 || initData.region || initData.k || !initData.edges.dirichlet() || !initData.flow.none() || warmStart.levels > 0) {
+							throw std::runtime_error("3d systems support neither packed problems, masks, coefficients, neumann and robin edges, convection nor warm start.");
+						}
+						initData3D = std::make_unique<InitData3D>(InitData3D::get(appParams.xSplit, appParams.ySplit, appParams.zSplit));
+					}
+					return *initData3D;
+				};
 
 				std::vector<SmartHandle> handles;
 				for (auto& [name, ptr] : *proxies) {
-					auto& proxy = ptr->get<Proxy>();
-					handles.push_back(proxy.createSmart(initData.domain, initData.data, {1}));
+					SmartHandle handle;
+					if (ptr->stores<dir3d::Proxy>()) {
+						auto& data3D = getInitData3D();
+						handle = ptr->get<dir3d::Proxy>().createSmart(data3D.domain, data3D.data, {1});
+					} else {
+						auto& proxy = ptr->get<Proxy>();
+						if (warmStart.levels > 0) {
+							auto data = create_warm_data(proxy, prolongateProgram, initData.domain, initData.boundary, initData.f, warmStart);
+							handle = proxy.createSmart(initData.domain, data, {1});
+						} else {
+							handle = proxy.createSmart(initData.domain, initData.data, {1});
+						}
+					}
+
+					// system rejected the problem: options of the config it doesn't support
+					if (handle.empty()) {
+						throw std::runtime_error("System " + name + " failed to create a handle for the configured problem.");
+					}
+					handles.push_back(std::move(handle));
 				}
 				return handles;
 			}
 
+			// one stepper per system, 3d systems and options of the steady problem are not supported
+			std::vector<ImplicitHeat> createHeats(const AppParams& appParams, ModulePtr proxies, ModulePtr programs)
+			{
+				if (appParams.warmStartLevels > 0) {
+					throw std::runtime_error("Implicit time steps are warm started from the previous step, nested iteration is not supported.");
+				}
+
+				auto initData = InitData::get(appParams.xSplit, appParams.ySplit, appParams.channels, appParams.shape, appParams.coefficient, appParams.boundary, appParams.convection, appParams.velocity);
+
+				HeatStepping stepping;
+				stepping.scheme  = (appParams.time == "crank_nicolson" ? TimeScheme::CrankNicolson : TimeScheme::BackwardEuler);
+				stepping.dt      = appParams.timeStep;
+				stepping.updates = (i32)appParams.stepUpdates;
+				stepping.params  = {1};
+
+				auto& programStorage = programs->get<ProgramStorage>();
+				if (!programStorage.has("heat_rhs")) {
+					throw std::runtime_error("Failed to obtain \"heat_rhs\" program.");
+				}
+				gl::Id rhsProgram = programStorage.find("heat_rhs")->second.program.id;
+
+				std::vector<ImplicitHeat> heats;
+				for (auto& [name, ptr] : *proxies) {
+					if (ptr->stores<dir3d::Proxy>()) {
+						throw std::runtime_error("3d systems don't support implicit time steps.");
+					}
+					heats.emplace_back(initData.domain, initData.boundary, initData.f, stepping, rhsProgram);
+				}
+				return heats;
+			}
+
 			template<class It>
 			json createTrackerOutput(It first, It last)
 			{
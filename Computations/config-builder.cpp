@@ -1,5 +1,6 @@
 #include "config-builder.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <stdexcept>
@@ -15,26 +16,111 @@ namespace
 		};
 	}
 
-	void get_app_config(json& config, uint xSplit, uint ySplit, uint totalUpdates, uint gridX, uint gridY)
+	void get_app_config(json& config, const ConfigParams& params)
 	{
 		config["app"] = {
-			{"x_split", xSplit},
-			{"y_split", ySplit},
-			{"total_updates", totalUpdates},
+			{"x_split", params.xSplit},
+			{"y_split", params.ySplit},
+			{"z_split", params.zSplit},
+			{"total_updates", params.totalUpdates},
 			{"iters_per_update", 1},
-			{"grid_x", gridX},
-			{"grid_y", gridY},
+			{"grid_x", params.gridX},
+			{"grid_y", params.gridY},
+			{"warm_start_levels", params.warmStartLevels},
+			{"warm_start_updates", params.warmStartUpdates},
+			{"channels", params.channels},
+			{"shape", params.shape},
+			{"coefficient", params.coefficient},
+			{"boundary", params.boundary},
+			{"time", params.time},
+			{"time_step", params.timeStep},
+			{"step_updates", params.stepUpdates},
+			{"convection", params.convection},
+			{"velocity", params.velocity},
 		};
 	}
 
-	void get_meta_config(json& config, uint xSplit, uint ySplit, uint steps, uint workgroupSizeX, uint workgroupSizeY)
+	// macro value, see shaders/swizzle.glsl
+	std::string get_swizzle_macro(const std::string& swizzle)
+	{
+		if (swizzle == "row_major") {
+			return "SWIZZLE_ROW_MAJOR";
+		}
+		if (swizzle == "morton") {
+			return "SWIZZLE_MORTON";
+		}
+		if (swizzle == "hilbert") {
+			return "SWIZZLE_HILBERT";
+		}
+		if (swizzle == "band") {
+			return "SWIZZLE_BAND";
+		}
+		throw std::runtime_error("Unknown workgroup swizzle: " + swizzle + ".");
+	}
+
+	// macro value, see shaders/convection.glsl
+	std::string get_convection_macro(const std::string& convection)
+	{
+		if (convection == "central") {
+			return "CONVECTION_CENTRAL";
+		}
+		if (convection == "upwind") {
+			return "CONVECTION_UPWIND";
+		}
+		throw std::runtime_error("Unknown convection scheme: " + convection + ".");
+	}
+
+	// macro value, see shaders/cache_layout.glsl
+	std::string get_cache_layout_macro(const std::string& layout)
+	{
+		if (layout == "column_major") {
+			return "CACHE_LAYOUT_COLUMN_MAJOR";
+		}
+		if (layout == "row_major") {
+			return "CACHE_LAYOUT_ROW_MAJOR";
+		}
+		if (layout == "padded") {
+			return "CACHE_LAYOUT_PADDED";
+		}
+		if (layout == "xor") {
+			return "CACHE_LAYOUT_XOR";
+		}
+		throw std::runtime_error("Unknown cache layout: " + layout + ".");
+	}
+
+	void get_meta_config(json& config, const ConfigParams& params)
 	{
 		config["metainfo"] = {
-			{"x_split", xSplit},
-			{"y_split", ySplit},
-			{"steps", steps},
-			{"workgroup_size_x", workgroupSizeX},
-			{"workgroup_size_y", workgroupSizeY},
+			{"x_split", params.xSplit},
+			{"y_split", params.ySplit},
+			{"z_split", params.zSplit},
+			{"steps", params.steps},
+			{"coarsen", params.coarsen},
+			{"colours", params.colours},
+			{"swizzle", params.swizzle},
+			{"swizzle_block", params.swizzleBlock},
+			{"cache_layout", params.cacheLayout},
+			{"subgroup_shuffle", params.subgroupShuffle},
+			{"workgroup_size_x", params.workgroupSizeX},
+			{"workgroup_size_y", params.workgroupSizeY},
+			{"workgroup_size_z", params.workgroupSizeZ},
+			{"tile_size_x", params.tileSizeX},
+			{"tile_size_y", params.tileSizeY},
+			{"stream_rows", params.streamRows},
+			{"storage_ghost", params.storageGhost},
+			{"rhs_expression", params.rhsExpression},
+			{"residual", params.residual},
+			{"warm_start_levels", params.warmStartLevels},
+			{"warm_start_updates", params.warmStartUpdates},
+			{"channels", params.channels},
+			{"shape", params.shape},
+			{"coefficient", params.coefficient},
+			{"boundary", params.boundary},
+			{"time", params.time},
+			{"time_step", params.timeStep},
+			{"step_updates", params.stepUpdates},
+			{"convection", params.convection},
+			{"velocity", params.velocity},
 		};
 	}
 
@@ -47,41 +133,275 @@ namespace
 		config["dirichlet"] = dirichlet;
 	}
 
-	void get_shader_storage_config(json& config, uint workgroupSizeX, uint workgroupSizeY, uint steps)
+	bool has_system(const ConfigParams& params, const std::string& system)
+	{
+		return std::find(params.systems.begin(), params.systems.end(), system) != params.systems.end();
+	}
+
+	// every system of the config is one of the supported
+	bool only_systems(const ConfigParams& params, std::initializer_list<std::string> supported)
 	{
-		if (workgroupSizeX % 2 != 0 || workgroupSizeY % 2 != 0) {
+		return std::all_of(params.systems.begin(), params.systems.end(), [&](const std::string& system) {
+			return std::find(supported.begin(), supported.end(), system) != supported.end();
+		});
+	}
+
+	void get_shader_storage_config(json& config, const ConfigParams& params)
+	{
+		if (params.workgroupSizeX % 2 != 0 || params.workgroupSizeY % 2 != 0) {
 			throw std::runtime_error("Workgroups dimensions must be even numbers.");
 		}
+		if (params.workgroupSizeZ == 0) {
+			throw std::runtime_error("Workgroup depth must be positive.");
+		}
+		if ((has_system(params, "jacoby_3d") || has_system(params, "red_black_3d") || has_system(params, "red_black_tiled_3d"))
+			&& params.workgroupSizeX * params.workgroupSizeY * params.workgroupSizeZ > 1024) {
+			throw std::runtime_error("3d workgroups must fit 1024 invocations.");
+		}
+		if (params.tileSizeX == 0 || params.tileSizeY == 0) {
+			throw std::runtime_error("Tile dimensions must be positive.");
+		}
+		if (params.streamRows == 0) {
+			throw std::runtime_error("Number of streamed rows must be positive.");
+		}
+		if (params.coarsen == 0) {
+			throw std::runtime_error("Coarsening factor must be positive.");
+		}
+		if (params.colours != 2 && params.colours != 4 && params.colours != 9) {
+			throw std::runtime_error("Number of tile colours must be 2, 4 or 9.");
+		}
+		if (params.swizzleBlock == 0) {
+			throw std::runtime_error("Swizzle block must be positive.");
+		}
+		if ((params.swizzle == "morton" || params.swizzle == "hilbert") && (params.swizzleBlock & (params.swizzleBlock - 1)) != 0) {
+			throw std::runtime_error("Swizzle block must be a power of two.");
+		}
+		if (has_system(params, "red_black_diamond") && (params.steps > (params.workgroupSizeX - 1) / 4 || params.steps > (params.workgroupSizeY - 1) / 4)) {
+			throw std::runtime_error("Diamond tiles require 4 * steps to be less than both workgroup sizes.");
+		}
+		if ((has_system(params, "jacoby_tiled") || has_system(params, "heat_tiled"))
+			&& (params.workgroupSizeX + 2 * params.steps) * (params.workgroupSizeY + 2 * params.steps) > 1024) {
+			throw std::runtime_error("Jacoby and heat tiles overlapped by steps on each side must fit 1024 invocations.");
+		}
+		if (has_system(params, "jacoby_smtm") && (params.workgroupSizeX + 2 * params.steps + 2) * (params.workgroupSizeY + 2 * params.steps + 2) > 1024) {
+			throw std::runtime_error("Jacoby smtm tiles overlapped by steps + 1 on each side must fit 1024 invocations.");
+		}
+		if (params.storageGhost != 0 && !params.storageSsbo) {
+			throw std::runtime_error("Ghost layers require buffer storage.");
+		}
+		if (params.channels != 1 && params.channels != 4) {
+			throw std::runtime_error("Number of grid channels must be 1 or 4.");
+		}
+		if (params.channels != 1 && !only_systems(params, {"jacoby", "red_black"})) {
+			throw std::runtime_error("Packed channels are supported by jacoby and red_black only.");
+		}
+		if (params.shape != "box" && params.shape != "l_shape" && params.shape != "perforated") {
+			throw std::runtime_error("Unknown domain shape: " + params.shape + ".");
+		}
+		if (params.shape != "box" && !only_systems(params, {"jacoby", "red_black"})) {
+			throw std::runtime_error("Masked domains are supported by jacoby and red_black only.");
+		}
+		if (params.coefficient != "constant" && params.coefficient != "layered" && params.coefficient != "checker") {
+			throw std::runtime_error("Unknown coefficient: " + params.coefficient + ".");
+		}
+		if (params.coefficient != "constant" && !only_systems(params, {"jacoby", "red_black", "jacoby_tiled"})) {
+			throw std::runtime_error("Variable coefficient is supported by jacoby, red_black and jacoby_tiled only.");
+		}
+		if (params.boundary != "dirichlet" && params.boundary != "neumann" && params.boundary != "robin" && params.boundary != "mixed") {
+			throw std::runtime_error("Unknown boundary conditions: " + params.boundary + ".");
+		}
+		if (params.boundary != "dirichlet" && (params.shape != "box" || params.coefficient != "constant")) {
+			throw std::runtime_error("Neumann and robin edges require the whole box and constant coefficient.");
+		}
+		if (params.boundary != "dirichlet" && !only_systems(params, {"jacoby", "jacoby_tiled", "red_black", "red_black_tiled", "red_black_smtm"})) {
+			throw std::runtime_error("Neumann and robin edges are supported by jacoby, jacoby_tiled, red_black, red_black_tiled and red_black_smtm only.");
+		}
+		if (params.time != "steady" && params.time != "backward_euler" && params.time != "crank_nicolson") {
+			throw std::runtime_error("Unknown time scheme: " + params.time + ".");
+		}
+		if (params.time != "steady" && (params.timeStep <= 0.0f || params.stepUpdates == 0)) {
+			throw std::runtime_error("Implicit time steps require positive time step and updates per step.");
+		}
+		if (params.time != "steady" && (params.channels != 1 || params.shape != "box" || params.coefficient != "constant" || params.boundary != "dirichlet")) {
+			throw std::runtime_error("Implicit time steps require a single problem of the whole box with constant coefficient and dirichlet edges.");
+		}
+		if (params.time != "steady" && !params.rhsExpression.empty()) {
+			throw std::runtime_error("Implicit time steps change f every step, so it must be a grid.");
+		}
+		if (params.time != "steady" && params.storageSsbo) {
+			throw std::runtime_error("Implicit time steps rebuild f of the step in the texture of the system, so storage must be texture.");
+		}
+		if (params.convection != "none" && params.convection != "central" && params.convection != "upwind") {
+			throw std::runtime_error("Unknown convection scheme: " + params.convection + ".");
+		}
+		if (params.convection != "none" && (params.channels != 1 || params.shape != "box" || params.coefficient != "constant" || params.boundary != "dirichlet" || params.time != "steady")) {
+			throw std::runtime_error("Convection requires a single steady problem of the whole box with constant coefficient and dirichlet edges.");
+		}
+		if (params.convection != "none" && !only_systems(params, {"jacoby_tiled", "red_black_tiled", "bicgstab"})) {
+			throw std::runtime_error("Convection is supported by jacoby_tiled, red_black_tiled and bicgstab only.");
+		}
 
 		// TODO : two config types are almost the same now
 		json simpleConfig = {
 			{"_CONFIGURED", ""},
-			{"_WORKGROUP_X", std::to_string(workgroupSizeX)},
-			{"_WORKGROUP_Y", std::to_string(workgroupSizeY)}
+			{"_WORKGROUP_X", std::to_string(params.workgroupSizeX)},
+			{"_WORKGROUP_Y", std::to_string(params.workgroupSizeY)}
 		};
 
 		json tiledConfig = {
 			{"_CONFIGURED", ""},
-			{"_STEPS", std::to_string(steps)},
-			{"_WORKGROUP_X", std::to_string(workgroupSizeX)},
-			{"_WORKGROUP_Y", std::to_string(workgroupSizeY)}
+			{"_STEPS", std::to_string(params.steps)},
+			{"_WORKGROUP_X", std::to_string(params.workgroupSizeX)},
+			{"_WORKGROUP_Y", std::to_string(params.workgroupSizeY)}
+		};
+
+		simpleConfig["_SWIZZLE"] = get_swizzle_macro(params.swizzle);
+		simpleConfig["_SWIZZLE_BLOCK"] = std::to_string(params.swizzleBlock);
+		tiledConfig["_SWIZZLE"] = get_swizzle_macro(params.swizzle);
+		tiledConfig["_SWIZZLE_BLOCK"] = std::to_string(params.swizzleBlock);
+		simpleConfig["_CACHE_LAYOUT"] = get_cache_layout_macro(params.cacheLayout);
+		tiledConfig["_CACHE_LAYOUT"] = get_cache_layout_macro(params.cacheLayout);
+
+		if (params.storageSsbo) {
+			simpleConfig["_STORAGE_SSBO"] = "";
+			tiledConfig["_STORAGE_SSBO"] = "";
+		}
+
+		// programs without rhs.glsl ignore it, their systems keep allocating f grid
+		if (!params.rhsExpression.empty()) {
+			simpleConfig["_RHS_EXPR"] = params.rhsExpression;
+			tiledConfig["_RHS_EXPR"] = params.rhsExpression;
+		}
+
+		// programs without residual.glsl ignore it
+		if (params.residual) {
+			simpleConfig["_RESIDUAL"] = "";
+			tiledConfig["_RESIDUAL"] = "";
+		}
+
+		json coarseConfig = simpleConfig;
+		coarseConfig["_COARSEN"] = std::to_string(params.coarsen);
+
+		json streamConfig = simpleConfig;
+		streamConfig["_TILE_Y"] = std::to_string(params.streamRows);
+
+		json stridedConfig = tiledConfig;
+		stridedConfig["_TILE_X"] = std::to_string(params.tileSizeX);
+		stridedConfig["_TILE_Y"] = std::to_string(params.tileSizeY);
+
+		json colourConfig = tiledConfig;
+		colourConfig["_COLOURS"] = std::to_string(params.colours);
+
+		// only jacoby and red_black programs are vectorized over channels, read cell mask and solve variable coefficient problems
+		json channelConfig = simpleConfig;
+		if (params.channels != 1) {
+			channelConfig["_GRID_CHANNELS"] = std::to_string(params.channels);
+		}
+		if (params.shape != "box") {
+			channelConfig["_MASK"] = "";
+		}
+		if (params.coefficient != "constant") {
+			channelConfig["_COEF"] = "";
+		}
+
+		// tiled jacoby solves variable coefficient problems too
+		json coefTiledConfig = tiledConfig;
+		if (params.coefficient != "constant") {
+			coefTiledConfig["_COEF"] = "";
+		}
+
+		// only red_black_smtm allocates padded grids
+		json ghostConfig = tiledConfig;
+		if (params.storageGhost != 0) {
+			ghostConfig["_STORAGE_GHOST"] = std::to_string(params.storageGhost);
+		}
+
+		// neumann and robin edges are updated by jacoby, jacoby_tiled, red_black, red_black_tiled and red_black_smtm
+		json boundaryTiledConfig = tiledConfig;
+		json boundaryGhostConfig = ghostConfig;
+		if (params.boundary != "dirichlet") {
+			channelConfig["_BOUNDARY"] = "";
+			coefTiledConfig["_BOUNDARY"] = "";
+			boundaryTiledConfig["_BOUNDARY"] = "";
+			boundaryGhostConfig["_BOUNDARY"] = "";
+		}
+
+		// implicit time steps are shifted problems, see shaders/shift.glsl
+		if (params.time != "steady") {
+			channelConfig["_SHIFT"] = "";
+			coefTiledConfig["_SHIFT"] = "";
+			boundaryTiledConfig["_SHIFT"] = "";
+			boundaryGhostConfig["_SHIFT"] = "";
+		}
+
+		// convective problems are smoothed by jacoby_tiled and red_black_tiled and solved by bicgstab, see shaders/convection.glsl
+		json convectionConfig = simpleConfig;
+		if (params.convection != "none") {
+			convectionConfig["_CONVECTION"] = get_convection_macro(params.convection);
+			coefTiledConfig["_CONVECTION"] = get_convection_macro(params.convection);
+			boundaryTiledConfig["_CONVECTION"] = get_convection_macro(params.convection);
+		}
+
+		// 3d programs: images only, f is always a grid
+		json volumeConfig = {
+			{"_CONFIGURED", ""},
+			{"_STEPS", std::to_string(params.steps)},
+			{"_WORKGROUP_X", std::to_string(params.workgroupSizeX)},
+			{"_WORKGROUP_Y", std::to_string(params.workgroupSizeY)},
+			{"_WORKGROUP_Z", std::to_string(params.workgroupSizeZ)}
 		};
+		if (params.residual) {
+			volumeConfig["_RESIDUAL"] = "";
+		}
 		
 		json shaders;
 		shaders["quad.frag"] = json::object();
 		shaders["quad.vert"] = json::object();
-		shaders["jacoby.comp"] = json::object({{"macros", simpleConfig}});
-		shaders["red_black.comp"] = json::object({{"macros", simpleConfig}});
-		shaders["red_black_tiled.comp"] = json::object({{"macros", tiledConfig}});
+		shaders["jacoby.comp"] = json::object({{"macros", channelConfig}});
+		shaders["red_black.comp"] = json::object({{"macros", channelConfig}});
+		shaders["jacoby_stream.comp"] = json::object({{"macros", streamConfig}});
+		shaders["red_black_stream.comp"] = json::object({{"macros", streamConfig}});
+		shaders["jacoby_coarse.comp"] = json::object({{"macros", coarseConfig}});
+		shaders["red_black_coarse.comp"] = json::object({{"macros", coarseConfig}});
+		shaders["jacoby_subgroup.comp"] = json::object({{"macros", simpleConfig}});
+		shaders["jacoby_tiled.comp"] = json::object({{"macros", coefTiledConfig}});
+		shaders["jacoby_tiled_strided.comp"] = json::object({{"macros", stridedConfig}});
+		shaders["jacoby_smtm_st0.comp"] = json::object({{"macros", tiledConfig}});
+		shaders["jacoby_smtm_st1.comp"] = json::object({{"macros", tiledConfig}});
+		shaders["red_black_subgroup.comp"] = json::object({{"macros", simpleConfig}});
+		shaders["red_black_persistent.comp"] = json::object({{"macros", simpleConfig}});
+		shaders["red_black_tiled.comp"] = json::object({{"macros", boundaryTiledConfig}});
+		shaders["red_black_tiled_strided.comp"] = json::object({{"macros", stridedConfig}});
+		shaders["red_black_diamond.comp"] = json::object({{"macros", tiledConfig}});
+		shaders["red_black_smtm_mc.comp"] = json::object({{"macros", colourConfig}});
 		shaders["red_black_smt_s.comp"] = json::object({{"macros", tiledConfig}});
 		shaders["red_black_smtm_s.comp"] = json::object({{"macros", tiledConfig}});
-		shaders["red_black_smtm_st0.comp"] = json::object({{"macros", tiledConfig}});
-		shaders["red_black_smtm_st1.comp"] = json::object({{"macros", tiledConfig}});
+		shaders["red_black_smtm_st0.comp"] = json::object({{"macros", boundaryGhostConfig}});
+		shaders["red_black_smtm_st1.comp"] = json::object({{"macros", boundaryGhostConfig}});
+		shaders["red_black_smtm_subgroup_st0.comp"] = json::object({{"macros", ghostConfig}});
+		shaders["red_black_smtm_subgroup_st1.comp"] = json::object({{"macros", ghostConfig}});
+		shaders["red_black_smtm_df.comp"] = json::object({{"macros", tiledConfig}});
 		shaders["red_black_smtmo_st0.comp"] = json::object({{"macros", tiledConfig}});
 		shaders["red_black_smtmo_st1.comp"] = json::object({{"macros", tiledConfig}});
 		shaders["chaotic_tiled.comp"] = json::object({{"macros", tiledConfig}});
 		shaders["chaotic_smtm_st0.comp"] = json::object({{"macros", tiledConfig}});
 		shaders["chaotic_smtm_st1.comp"] = json::object({{"macros", tiledConfig}});
+		shaders["chaotic_smtm_subgroup_st0.comp"] = json::object({{"macros", tiledConfig}});
+		shaders["chaotic_smtm_subgroup_st1.comp"] = json::object({{"macros", tiledConfig}});
+		shaders["chaotic_smtm_df.comp"] = json::object({{"macros", tiledConfig}});
+		shaders["jacoby_3d.comp"] = json::object({{"macros", volumeConfig}});
+		shaders["red_black_3d.comp"] = json::object({{"macros", volumeConfig}});
+		shaders["heat_tiled.comp"] = json::object({{"macros", tiledConfig}});
+		shaders["jacoby_mehrstellen.comp"] = json::object({{"macros", simpleConfig}});
+		shaders["red_black_mehrstellen.comp"] = json::object({{"macros", simpleConfig}});
+		shaders["red_black_tiled_3d.comp"] = json::object({{"macros", volumeConfig}});
+		shaders["bicgstab.comp"] = json::object({{"macros", convectionConfig}});
+		shaders["bicgstab_reduce.comp"] = json::object();
+		shaders["line_zebra.comp"] = json::object({{"macros", simpleConfig}});
+		shaders["adi.comp"] = json::object({{"macros", simpleConfig}});
+		shaders["residual_reduce.comp"] = json::object();
+		shaders["prolongate.comp"] = json::object();
+		shaders["heat_rhs.comp"] = json::object();
 		shaders["test_compute.comp"] = json::object();
 
 		json shader_storage;
@@ -91,23 +411,61 @@ namespace
 		config["shader_storage"] = shader_storage;
 	}
 
-	void get_program_storage_config(json& config)
+	void get_program_storage_config(json& config, bool subgroupShuffle)
 	{
 		config["program_storage"] = {
 			{"quad", json::array({"quad.frag", "quad.vert"})},
 			{"jacoby", json::array({"jacoby.comp"})},
 			{"red_black", json::array({"red_black.comp"})},
+			{"jacoby_stream", json::array({"jacoby_stream.comp"})},
+			{"red_black_stream", json::array({"red_black_stream.comp"})},
+			{"jacoby_coarse", json::array({"jacoby_coarse.comp"})},
+			{"red_black_coarse", json::array({"red_black_coarse.comp"})},
+			{"jacoby_tiled", json::array({"jacoby_tiled.comp"})},
+			{"jacoby_tiled_strided", json::array({"jacoby_tiled_strided.comp"})},
+			{"jacoby_smtm_st0", json::array({"jacoby_smtm_st0.comp"})},
+			{"jacoby_smtm_st1", json::array({"jacoby_smtm_st1.comp"})},
+			{"red_black_persistent", json::array({"red_black_persistent.comp"})},
 			{"red_black_tiled", json::array({"red_black_tiled.comp"})},
+			{"red_black_tiled_strided", json::array({"red_black_tiled_strided.comp"})},
+			{"red_black_diamond", json::array({"red_black_diamond.comp"})},
+			{"red_black_smtm_mc", json::array({"red_black_smtm_mc.comp"})},
 			{"red_black_smtm_s", json::array({"red_black_smtm_s.comp"})},
 			{"red_black_smtm_st0", json::array({"red_black_smtm_st0.comp"})},
 			{"red_black_smtm_st1", json::array({"red_black_smtm_st1.comp"})},
+			{"red_black_smtm_df", json::array({"red_black_smtm_df.comp"})},
 			{"red_black_smtmo_st0", json::array({"red_black_smtmo_st0.comp"})},
 			{"red_black_smtmo_st1", json::array({"red_black_smtmo_st1.comp"})},
 			{"chaotic_tiled", json::array({"chaotic_tiled.comp"})},
 			{"chaotic_smtm_st0", json::array({"chaotic_smtm_st0.comp"})},
 			{"chaotic_smtm_st1", json::array({"chaotic_smtm_st1.comp"})},
+			{"chaotic_smtm_df", json::array({"chaotic_smtm_df.comp"})},
+			{"heat_tiled", json::array({"heat_tiled.comp"})},
+			{"jacoby_mehrstellen", json::array({"jacoby_mehrstellen.comp"})},
+			{"red_black_mehrstellen", json::array({"red_black_mehrstellen.comp"})},
+			{"jacoby_3d", json::array({"jacoby_3d.comp"})},
+			{"red_black_3d", json::array({"red_black_3d.comp"})},
+			{"red_black_tiled_3d", json::array({"red_black_tiled_3d.comp"})},
+			{"bicgstab", json::array({"bicgstab.comp"})},
+			{"bicgstab_reduce", json::array({"bicgstab_reduce.comp"})},
+			{"line_zebra", json::array({"line_zebra.comp"})},
+			{"adi", json::array({"adi.comp"})},
+			{"residual_reduce", json::array({"residual_reduce.comp"})},
+			{"prolongate", json::array({"prolongate.comp"})},
+			{"heat_rhs", json::array({"heat_rhs.comp"})},
 			{"test_compute", json::array({"test_compute.comp"})}
 		};
+
+		// dirichlet builders pick these variants up if the device supports subgroup shuffles
+		if (subgroupShuffle) {
+			auto& programs = config["program_storage"];
+			programs["jacoby_subgroup"] = json::array({"jacoby_subgroup.comp"});
+			programs["red_black_subgroup"] = json::array({"red_black_subgroup.comp"});
+			programs["red_black_smtm_subgroup_st0"] = json::array({"red_black_smtm_subgroup_st0.comp"});
+			programs["red_black_smtm_subgroup_st1"] = json::array({"red_black_smtm_subgroup_st1.comp"});
+			programs["chaotic_smtm_subgroup_st0"] = json::array({"chaotic_smtm_subgroup_st0.comp"});
+			programs["chaotic_smtm_subgroup_st1"] = json::array({"chaotic_smtm_subgroup_st1.comp"});
+		}
 	}
 
 	void get_window_config(json& config, uint width, uint height)
@@ -128,13 +486,13 @@ namespace
 json ConfigBuilder::build()
 {
 	json config;
-	get_output_config(config, m_output);
-	get_app_config(config, m_xSplit, m_ySplit, m_totalUpdates, m_gridX, m_gridY);
-	get_meta_config(config, m_xSplit, m_ySplit, m_steps, m_workgroupSizeX, m_workgroupSizeY);
-	get_dirichlet_config(config, m_systems);
-	get_shader_storage_config(config, m_workgroupSizeX, m_workgroupSizeY, m_steps);
-	get_program_storage_config(config);
-	get_window_config(config, m_windowWidth, m_windowHeight);
+	get_output_config(config, m_params.output);
+	get_app_config(config, m_params);
+	get_meta_config(config, m_params);
+	get_dirichlet_config(config, m_params.systems);
+	get_shader_storage_config(config, m_params);
+	get_program_storage_config(config, m_params.subgroupShuffle);
+	get_window_config(config, m_params.windowWidth, m_params.windowHeight);
 	get_glfw_config(config);
 	return config;
 }
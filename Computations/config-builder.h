@@ -6,6 +6,52 @@
 #include <string>
 #include <vector>
 
+// values of the config, set by ConfigBuilder(see its setters for the meaning)
+struct ConfigParams
+{
+	std::string output;
+	std::vector<std::string> systems;
+
+	uint gridX{3};
+	uint gridY{2};
+	
+	uint windowWidth{1200};
+	uint windowHeight{800};
+
+	uint xSplit{256};
+	uint ySplit{256};
+	uint zSplit{64};
+	uint totalUpdates{1000};
+	uint workgroupSizeX{16};
+	uint workgroupSizeY{16};
+	uint workgroupSizeZ{4};
+	uint tileSizeX{64};
+	uint tileSizeY{64};
+	uint streamRows{128};
+	uint steps{2};
+	uint coarsen{4};
+	uint colours{4};
+	std::string swizzle{"row_major"};
+	uint swizzleBlock{8};
+	std::string cacheLayout{"column_major"};
+	bool subgroupShuffle{true};
+	bool storageSsbo{false};
+	uint storageGhost{0};
+	std::string rhsExpression;
+	bool residual{false};
+	uint warmStartLevels{0};
+	uint warmStartUpdates{100};
+	uint channels{1};
+	std::string shape{"box"};
+	std::string coefficient{"constant"};
+	std::string boundary{"dirichlet"};
+	std::string time{"steady"};
+	f32 timeStep{0.01f};
+	uint stepUpdates{50};
+	std::string convection{"none"};
+	f32 velocity{10.0f};
+};
+
 class ConfigBuilder
 {
 public:
@@ -14,81 +60,224 @@ public:
 
 	void setOutput(const std::string& value)
 	{
-		m_output = value;
+		m_params.output = value;
 	}
 
 	void setSystems(const std::vector<std::string>& value)
 	{
-		m_systems = value;
+		m_params.systems = value;
 	}
 
 
 	void setGridX(uint value)
 	{
-		m_gridX = value;
+		m_params.gridX = value;
 	}
 
 	void setGridY(uint value)
 	{
-		m_gridY = value;
+		m_params.gridY = value;
 	}
 
 
 	void setWindowWidth(uint value)
 	{
-		m_windowWidth = value;
+		m_params.windowWidth = value;
 	}
 
 	void setWindowHeight(uint value)
 	{
-		m_windowHeight = value;
+		m_params.windowHeight = value;
 	}
 
 
 	void setSplitX(uint value)
 	{	
-		m_xSplit = value;
+		m_params.xSplit = value;
 	}
 
 	void setSplitY(uint value)
 	{
-		m_ySplit = value;
+		m_params.ySplit = value;
+	}
+
+	// used only by 3d systems
+	void setSplitZ(uint value)
+	{
+		m_params.zSplit = value;
 	}
 
 	void setTotalUpdates(uint value)
 	{
-		m_totalUpdates = value;
+		m_params.totalUpdates = value;
 	}
 
 	void setWorkgroupSizeX(uint value)
 	{
-		m_workgroupSizeX = value;
+		m_params.workgroupSizeX = value;
 	}
 
 	void setWorkgroupSizeY(uint value)
 	{
-		m_workgroupSizeY = value;
+		m_params.workgroupSizeY = value;
+	}
+
+	// used only by 3d programs
+	void setWorkgroupSizeZ(uint value)
+	{
+		m_params.workgroupSizeZ = value;
+	}
+
+	// tile of strided programs, independent of the workgroup size
+	void setTileSizeX(uint value)
+	{
+		m_params.tileSizeX = value;
+	}
+
+	void setTileSizeY(uint value)
+	{
+		m_params.tileSizeY = value;
+	}
+
+	// rows a workgroup of streaming programs marches over
+	void setStreamRows(uint value)
+	{
+		m_params.streamRows = value;
 	}
 
 	void setSteps(uint value)
 	{
-		m_steps = value;
+		m_params.steps = value;
 	}
 
-private:
-	std::string m_output;
-	std::vector<std::string> m_systems;
+	void setCoarsen(uint value)
+	{
+		m_params.coarsen = value;
+	}
 
-	uint m_gridX{3};
-	uint m_gridY{2};
-	
-	uint m_windowWidth{1200};
-	uint m_windowHeight{800};
-
-	uint m_xSplit{256};
-	uint m_ySplit{256};
-	uint m_totalUpdates{1000};
-	uint m_workgroupSizeX{16};
-	uint m_workgroupSizeY{16};
-	uint m_steps{2};
-};
\ No newline at end of file
+	void setColours(uint value)
+	{
+		m_params.colours = value;
+	}
+
+	// row_major, morton, hilbert or band
+	void setSwizzle(const std::string& value)
+	{
+		m_params.swizzle = value;
+	}
+
+	void setSwizzleBlock(uint value)
+	{
+		m_params.swizzleBlock = value;
+	}
+
+	// column_major, row_major, padded or xor
+	void setCacheLayout(const std::string& value)
+	{
+		m_params.cacheLayout = value;
+	}
+
+	// jacoby, red_black, red_black_smtm and chaotic_smtm run their subgroup variants where the device supports shuffles,
+	// false keeps the plain programs on any device
+	void setSubgroupShuffle(bool value)
+	{
+		m_params.subgroupShuffle = value;
+	}
+
+	void setStorageSsbo(bool value)
+	{
+		m_params.storageSsbo = value;
+	}
+
+	// ghost layers of padded buffer grids(red_black_smtm only), 2 * steps layers or more remove bounds checks of edge tiles
+	void setStorageGhost(uint value)
+	{
+		m_params.storageGhost = value;
+	}
+
+	// glsl expression of x and y evaluated by programs instead of reading f grid, empty - f grid is used
+	// must describe the same function as the one used to create problem data
+	void setRhsExpression(const std::string& value)
+	{
+		m_params.rhsExpression = value;
+	}
+
+	// fused max |u_new - u_old| of jacoby, red_black and red_black_tiled programs, reduced once per update
+	void setResidual(bool value)
+	{
+		m_params.residual = value;
+	}
+
+	// nested iteration: every system solves the problem on 2^levels, ..., 2 x coarsened grids first,
+	// each solution is prolongated and used as the initial guess of the next grid, 0 - interior starts at zero
+	void setWarmStartLevels(uint value)
+	{
+		m_params.warmStartLevels = value;
+	}
+
+	// updates of the system on each coarse level
+	void setWarmStartUpdates(uint value)
+	{
+		m_params.warmStartUpdates = value;
+	}
+
+	// problems packed into rgba channels of one handle(jacoby and red_black only), 1 or 4
+	void setChannels(uint value)
+	{
+		m_params.channels = value;
+	}
+
+	// domain embedded in the box: box, l_shape or perforated, masked domains are solved by jacoby and red_black only
+	void setShape(const std::string& value)
+	{
+		m_params.shape = value;
+	}
+
+	// k of div(k grad u) = f: constant(k = 1), layered or checker, jacoby, jacoby_tiled and red_black only
+	void setCoefficient(const std::string& value)
+	{
+		m_params.coefficient = value;
+	}
+
+	// edges of the box: dirichlet, neumann(x edges), robin(x edges) or mixed(neumann left, robin right and bottom),
+	// neumann and robin edges are updated by jacoby, jacoby_tiled, red_black, red_black_tiled and red_black_smtm only
+	void setBoundary(const std::string& value)
+	{
+		m_params.boundary = value;
+	}
+
+	// heat equation u_t = div(grad(u)) - f: steady(poisson problem), backward_euler or crank_nicolson,
+	// each update is one implicit time step solved by the system, only jacoby, jacoby_tiled, red_black, red_black_tiled
+	// and red_black_smtm solve the shifted problems of the steps, heat_tiled is explicit and runs in the steady mode
+	void setTime(const std::string& value)
+	{
+		m_params.time = value;
+	}
+
+	void setTimeStep(f32 value)
+	{
+		m_params.timeStep = value;
+	}
+
+	// updates of the system per implicit time step, each step is warm started from the previous one
+	void setStepUpdates(uint value)
+	{
+		m_params.stepUpdates = value;
+	}
+
+	// convection-diffusion problem div(grad(u)) + b * grad(u) = f: none(poisson problem), central or upwind differences of grad(u),
+	// convective problems are solved by jacoby_tiled, red_black_tiled(gauss-seidel) and bicgstab only
+	void setConvection(const std::string& value)
+	{
+		m_params.convection = value;
+	}
+
+	// b = (velocity, velocity), flow along the diagonal of the box
+	void setVelocity(f32 value)
+	{
+		m_params.velocity = value;
+	}
+
+private:
+	ConfigParams m_params;
+};
@@ -0,0 +1,263 @@
+#include "adi.h"
+
+#include <cmath>
+#include <algorithm>
+#include <exception>
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+namespace dir2d
+{
+	namespace
+	{
+		// bounds of the spectrum of -D(second difference) of the axis
+		f64 min_eigenvalue(f64 h, i32 split)
+		{
+			f64 s = std::sin(pid2 / split);
+			return 4.0 / (h * h) * s * s;
+		}
+
+		f64 max_eigenvalue(f64 h, i32 split)
+		{
+			f64 c = std::cos(pid2 / split);
+			return 4.0 / (h * h) * c * c;
+		}
+
+		// geometric sequence over the spectrum of both axes, one parameter per decade of its condition number
+		std::vector<f32> compute_adi_parameters(const DomainAabb2D& domain)
+		{
+			f64 lo = std::min(min_eigenvalue(domain.hx, domain.xSplit), min_eigenvalue(domain.hy, domain.ySplit));
+			f64 hi = std::max(max_eigenvalue(domain.hx, domain.xSplit), max_eigenvalue(domain.hy, domain.ySplit));
+			i32 count = std::max(1, (i32)std::ceil(std::log10(hi / lo)));
+
+			std::vector<f32> rho(count);
+			for (i32 j = 0; j < count; j++) {
+				rho[j] = lo * std::pow(hi / lo, (2.0 * j + 1.0) / (2.0 * count));
+			}
+			return rho;
+		}
+
+		// (rho - D) of the lines of the axis
+		TridiagonalLine create_half_step_line(f64 h, i32 split, f64 rho)
+		{
+			f64 ihh = 1.0 / (h * h);
+			return {-ihh, rho + 2.0 * ihh, -ihh, split - 1};
+		}
+	}
+
+
+	// uniforms
+	Adi::Uniforms::Uniforms(gl::Id program)
+	{
+		setup(program);
+		if (!valid()) {
+			throw std::runtime_error("Failed to get uniform locations from adi program.");
+		}
+	}
+
+	void Adi::Uniforms::setup(gl::Id program)
+	{
+		axis = glGetUniformLocation(program, "axis");
+		rho  = glGetUniformLocation(program, "rho");
+		hx   = glGetUniformLocation(program, "hx");
+		hy   = glGetUniformLocation(program, "hy");
+	}
+
+	bool Adi::Uniforms::valid() const
+	{
+		return axis != -1 && rho != -1 && hx != -1 && hy != -1;
+	}
+
+
+	// solution
+	bool Adi::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, RhsType rhs)
+	{
+		i32 xVar = domain.xSplit + 1;
+		i32 yVar = domain.ySplit + 1;
+
+		// temporary grid starts as a copy, so it has the boundary values
+		GridStorage::create(solution.s, storage, xVar, yVar, data.solution.get());
+		GridStorage::create(solution.t, storage, xVar, yVar, data.solution.get());
+
+		if (rhs == RhsType::Grid) {
+			GridStorage::create(solution.f, storage, xVar, yVar, data.f.get());
+		}
+
+		bool tables = true;
+		solution.rho = compute_adi_parameters(domain);
+		for (f32 rho : solution.rho) {
+			solution.rows.push_back(create_tridiagonal_buffer(create_half_step_line(domain.hx, domain.xSplit, rho)));
+			solution.columns.push_back(create_tridiagonal_buffer(create_half_step_line(domain.hy, domain.ySplit, rho)));
+			tables = tables && solution.rows.back().valid() && solution.columns.back().valid();
+		}
+
+		return solution.s.valid() && solution.t.valid() && (rhs == RhsType::Analytic || solution.f.valid()) && tables;
+	}
+
+	gl::Id Adi::Solution::texture() const
+	{
+		return s.texture();
+	}
+
+	void Adi::Solution::sync() const
+	{
+		s.sync();
+	}
+
+
+	// method
+	// one workgroup solves a whole line, workgroup sizes are kept for create_one_shader_sys only
+	Adi::Adi([[maybe_unused]] uint workgroupSizeX, [[maybe_unused]] uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id residualProgram)
+		: m_storage{storage}
+		, m_program{program}
+		, m_residualProgram{program_has_residual(program) ? residualProgram : gl::null}
+		, m_uniforms(m_program)
+		, m_gridUniforms(m_program)
+		, m_rhsUniforms(m_program)
+	{}
+
+	Handle Adi::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || data.shift != 0.0f || !data.convection.none()) {
+			return null_handle;
+		}
+
+		// rows and columns must fit into shared memory and have interior points
+		if (domain.xSplit - 1 > tridiagonal_max || domain.ySplit - 1 > tridiagonal_max || domain.xSplit < 2 || domain.ySplit < 2) {
+			return null_handle;
+		}
+
+		Handle handle = acquire();
+
+		Solution solution;
+		if (!Solution::create(solution, domain, data, m_storage, m_rhsUniforms.type())) {
+			return null_handle;
+		}
+
+		// one partial per line of the longer half step
+		if (m_residualProgram != gl::null) {
+			if (!ResidualStorage::create(solution.residual, std::max(domain.xSplit, domain.ySplit) - 1)) {
+				return null_handle;
+			}
+		}
+
+		m_domainStorage.emplace(handle, domain);
+		m_solutionStorage.emplace(handle, std::move(solution));
+		m_configStorage.emplace(handle, config);
+
+		return handle;
+	}
+
+	SmartHandle Adi::createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		Handle handle = create(domain, data, config);
+		if (handle == null_handle) {
+			return SmartHandle{};
+		}
+		return provideHandle(handle, this);
+	}
+
+	bool Adi::valid(Handle handle) const
+	{
+		return m_domainStorage.has(handle); // can check only first
+	}
+
+	void Adi::destroy(Handle handle)
+	{
+		m_domainStorage.remove(handle);
+		m_solutionStorage.remove(handle);
+		m_configStorage.remove(handle);
+	}
+
+	const DomainAabb2D& Adi::domain(Handle handle) const
+	{
+		return m_domainStorage.get(handle);
+	}
+
+	gl::Id Adi::texture(Handle handle) const
+	{
+		return m_solutionStorage.get(handle).texture();
+	}
+
+	void Adi::update()
+	{
+		constexpr int IMGSRC = 0;
+		constexpr int IMGDST = 1;
+		constexpr int IMGF = 2;
+
+		glUseProgram(m_program);
+
+		m_query.start();
+		for (auto& handle : m_domainStorage) {
+			auto& domain   = m_domainStorage.get(handle);
+			auto& solution = m_solutionStorage.get(handle);
+			auto& config   = m_configStorage.get(handle);
+
+			if (m_rhsUniforms.type() == RhsType::Grid) {
+				solution.f.bind(IMGF, GL_READ_ONLY);
+			}
+			m_gridUniforms.set(solution.s);
+			m_rhsUniforms.set(domain);
+			if (m_residualProgram != gl::null) {
+				solution.residual.clear();
+				solution.residual.bind();
+			}
+
+			glUniform1f(m_uniforms.hx, domain.hx);
+			glUniform1f(m_uniforms.hy, domain.hy);
+
+			for (i32 i = 0; i < config.itersPerUpdate; i++) {
+				glUniform1f(m_uniforms.rho, solution.rho[solution.next]);
+
+				// rows: solution -> temporary
+				solution.s.bind(IMGSRC, GL_READ_ONLY);
+				solution.t.bind(IMGDST, GL_READ_WRITE);
+				glBindBufferBase(GL_SHADER_STORAGE_BUFFER, tridiagonal_binding, solution.rows[solution.next].id);
+				glUniform1i(m_uniforms.axis, 0);
+				glDispatchCompute(domain.ySplit - 1, 1, 1);
+				glMemoryBarrier(get_storage_barrier(m_storage));
+
+				// columns: temporary -> solution
+				solution.t.bind(IMGSRC, GL_READ_ONLY);
+				solution.s.bind(IMGDST, GL_READ_WRITE);
+				glBindBufferBase(GL_SHADER_STORAGE_BUFFER, tridiagonal_binding, solution.columns[solution.next].id);
+				glUniform1i(m_uniforms.axis, 1);
+				glDispatchCompute(domain.xSplit - 1, 1, 1);
+				glMemoryBarrier(get_storage_barrier(m_storage));
+
+				solution.next = (solution.next + 1) % (i32)solution.rho.size();
+			}
+		}
+
+		// reduce pass of the partials accumulated by the updates
+		if (m_residualProgram != gl::null) {
+			for (auto handle : m_domainStorage) {
+				m_solutionStorage.get(handle).residual.reduce(m_residualProgram);
+			}
+		}
+		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
+	}
+
+	GLuint64 Adi::elapsed() const
+	{
+		return m_query.elapsed();
+	}
+
+	f64 Adi::elapsedMean() const
+	{
+		return m_query.elapsedMean();
+	}
+
+	f32 Adi::residual(Handle handle) const
+	{
+		if (m_residualProgram == gl::null) {
+			return -1.0f;
+		}
+		return m_solutionStorage.get(handle).residual.value();
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <core.h>
+#include <handle.h>
+#include <storage.h>
+#include <handle-pool.h>
+
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+#include <vector>
+
+#include "time_query.h"
+#include "grid_storage.h"
+#include "rhs.h"
+#include "residual.h"
+#include "tridiagonal.h"
+#include "dirichlet_cfg.h"
+#include "dirichlet_handle.h"
+#include "resource_provider.h"
+#include "dirichlet_dataaabb2d.h"
+#include "dirichlet_domainaabb2d.h"
+
+namespace dir2d
+{
+	// peaceman-rachford adi: an iteration is implicit along rows, explicit along columns, then the other way round,
+	// every half step solves all interior lines by cyclic reduction on gpu(see shaders/tridiagonal.glsl)
+	// parameters cycle through a geometric sequence spanning the spectrum of both axes, so anisotropic grids(hx << hy) converge fast too
+	// scalar problems of the whole box with constant coefficient and dirichlet edges only, line has at most tridiagonal_max unknowns
+	class Adi
+		: public HandlePool
+		, public SmartHandleProvider
+		, public IResourceProvider
+	{
+	public:
+		struct Uniforms
+		{
+			Uniforms(gl::Id program);
+
+			void setup(gl::Id program);
+			bool valid() const;
+
+			GLint axis{-1};
+			GLint rho{-1};
+			GLint hx{-1};
+			GLint hy{-1};
+		};
+
+		struct Solution
+		{
+			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, RhsType rhs);
+
+			gl::Id texture() const;
+			void sync() const;
+
+			GridStorage s{}; // solution
+			GridStorage t{}; // result of the row half step, keeps boundary values
+			GridStorage f{}; // f - function from description of a problem, not allocated for analytic rhs
+			ResidualStorage residual; // allocated only if residual is tracked
+			std::vector<f32> rho; // parameters of the cycle
+			std::vector<gl::Buffer> rows;    // cyclic reduction table of the rows per parameter
+			std::vector<gl::Buffer> columns; // cyclic reduction table of the columns per parameter
+			i32 next{}; // parameter of the next iteration
+		};
+
+	public:
+		// workgroup of the program is flattened along the lines, so its size doesn't change the dispatches
+		// residualProgram - reduce program of residual partials, residual is tracked only if program writes partials
+		Adi(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id residualProgram = gl::null);
+
+		~Adi() = default;
+
+		Adi(const Adi&) = delete;
+		Adi& operator = (const Adi&) = delete;
+
+		Adi(Adi&&) noexcept = delete;
+		Adi& operator = (Adi&&) noexcept = delete;
+
+	public:
+		Handle create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+		SmartHandle createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+
+	public: // IResourceProvider
+		bool valid(Handle handle) const override;
+		void destroy(Handle handle) override;
+
+		const DomainAabb2D& domain(Handle handle) const override;
+		gl::Id texture(Handle handle) const override;
+
+	public:
+		void update();
+
+		GLuint64 elapsed() const;
+		f64 elapsedMean() const;
+
+		// max |u_new - u_old| over both half steps of the last update, negative if residual is not tracked
+		f32 residual(Handle handle) const;
+
+	private:
+		StorageType m_storage{};
+
+		gl::Id m_program;
+		gl::Id m_residualProgram;
+		Uniforms m_uniforms;
+		GridUniforms m_gridUniforms;
+		RhsUniforms m_rhsUniforms;
+		TimeQuery m_query;
+
+		Storage<DomainAabb2D> m_domainStorage;
+		Storage<Solution>     m_solutionStorage;
+		Storage<UpdateParams> m_configStorage;
+	};
+}
@@ -0,0 +1,253 @@
+#include "bicgstab.h"
+
+#include <cstddef>
+#include <exception>
+#include <initializer_list>
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include "dirichlet_util.h"
+
+namespace dir2d
+{
+	// uniforms
+	BiCGStab::Uniforms::Uniforms(gl::Id program)
+	{
+		setup(program);
+		if (!valid()) {
+			throw std::runtime_error("Failed to get uniform locations from bicgstab program.");
+		}
+	}
+
+	void BiCGStab::Uniforms::setup(gl::Id program)
+	{
+		stage = glGetUniformLocation(program, "stage");
+		hx    = glGetUniformLocation(program, "hx");
+		hy    = glGetUniformLocation(program, "hy");
+	}
+
+	bool BiCGStab::Uniforms::valid() const
+	{
+		return stage != -1 && hx != -1 && hy != -1;
+	}
+
+
+	// reduce uniforms
+	BiCGStab::ReduceUniforms::ReduceUniforms(gl::Id program)
+	{
+		setup(program);
+		if (!valid()) {
+			throw std::runtime_error("Failed to get uniform locations from bicgstab reduce program.");
+		}
+	}
+
+	void BiCGStab::ReduceUniforms::setup(gl::Id program)
+	{
+		count = glGetUniformLocation(program, "count");
+		stage = glGetUniformLocation(program, "stage");
+	}
+
+	bool BiCGStab::ReduceUniforms::valid() const
+	{
+		return count != -1 && stage != -1;
+	}
+
+
+	// solution
+	bool BiCGStab::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, i32 partials)
+	{
+		i32 xVar = domain.xSplit + 1;
+		i32 yVar = domain.ySplit + 1;
+
+		GridStorage::create(solution.x, storage, xVar, yVar, data.solution.get());
+		GridStorage::create(solution.f, storage, xVar, yVar, data.f.get());
+
+		// vectors are zero-initialized, the program never writes their edges
+		bool vectors = true;
+		for (GridStorage* vector : {&solution.r, &solution.rh, &solution.p, &solution.v, &solution.s, &solution.t}) {
+			GridStorage::create(*vector, storage, xVar, yVar, nullptr);
+			vectors = vectors && vector->valid();
+		}
+
+		solution.count = partials;
+		solution.partials = gl::create_storage_buffer(partials * 2 * sizeof(f32), GL_DYNAMIC_STORAGE_BIT);
+		solution.scalars = gl::create_storage_buffer(sizeof(Scalars), GL_DYNAMIC_STORAGE_BIT);
+
+		solution.convection = data.convection;
+
+		return solution.x.valid() && solution.f.valid() && vectors && solution.partials.valid() && solution.scalars.valid();
+	}
+
+	gl::Id BiCGStab::Solution::texture() const
+	{
+		return x.texture();
+	}
+
+	void BiCGStab::Solution::sync() const
+	{
+		x.sync();
+	}
+
+	void BiCGStab::Solution::bind() const
+	{
+		x.bind(0, GL_READ_WRITE);
+		r.bind(1, GL_READ_WRITE);
+		rh.bind(2, GL_READ_WRITE);
+		p.bind(3, GL_READ_WRITE);
+		v.bind(4, GL_READ_WRITE);
+		s.bind(5, GL_READ_WRITE);
+		t.bind(6, GL_READ_WRITE);
+		f.bind(7, GL_READ_ONLY);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bicgstab_partials_binding, partials.id);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bicgstab_scalars_binding, scalars.id);
+	}
+
+
+	// method
+	BiCGStab::BiCGStab(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id reduceProgram)
+		: m_workgroupSizeX{workgroupSizeX}
+		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
+		, m_program{program}
+		, m_reduceProgram{reduceProgram}
+		, m_uniforms(m_program)
+		, m_reduceUniforms(m_reduceProgram)
+		, m_gridUniforms(m_program)
+		, m_convectionUniforms(m_program)
+	{}
+
+	Handle BiCGStab::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || data.shift != 0.0f) {
+			return null_handle;
+		}
+		if (!data.convection.none() && !m_convectionUniforms.enabled()) {
+			return null_handle;
+		}
+
+		Handle handle = acquire();
+
+		auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+
+		Solution solution;
+		if (!Solution::create(solution, domain, data, m_storage, numWorkgroupsX * numWorkgroupsY)) {
+			return null_handle;
+		}
+
+		// initial residual and scalars
+		glUseProgram(m_program);
+		solution.bind();
+		m_gridUniforms.set(solution.x);
+		m_convectionUniforms.set(solution.convection);
+		glUniform1f(m_uniforms.hx, domain.hx);
+		glUniform1f(m_uniforms.hy, domain.hy);
+		dispatch(domain, solution, Stage::Init);
+
+		m_domainStorage.emplace(handle, domain);
+		m_solutionStorage.emplace(handle, std::move(solution));
+		m_configStorage.emplace(handle, config);
+
+		return handle;
+	}
+
+	SmartHandle BiCGStab::createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		Handle handle = create(domain, data, config);
+		if (handle == null_handle) {
+			return SmartHandle{};
+		}
+		return provideHandle(handle, this);
+	}
+
+	bool BiCGStab::valid(Handle handle) const
+	{
+		return m_domainStorage.has(handle); // can check only first
+	}
+
+	void BiCGStab::destroy(Handle handle)
+	{
+		m_domainStorage.remove(handle);
+		m_solutionStorage.remove(handle);
+		m_configStorage.remove(handle);
+	}
+
+	const DomainAabb2D& BiCGStab::domain(Handle handle) const
+	{
+		return m_domainStorage.get(handle);
+	}
+
+	gl::Id BiCGStab::texture(Handle handle) const
+	{
+		return m_solutionStorage.get(handle).texture();
+	}
+
+	void BiCGStab::dispatch(const DomainAabb2D& domain, const Solution& solution, Stage stage) const
+	{
+		// vectors are images or buffers, partials and scalars are buffers
+		constexpr GLbitfield barrier = GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT;
+
+		auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+
+		glUseProgram(m_program);
+		glUniform1i(m_uniforms.stage, (GLint)stage);
+		glDispatchCompute(numWorkgroupsX, numWorkgroupsY, 1);
+		glMemoryBarrier(barrier);
+
+		if (stage != Stage::P) {
+			glUseProgram(m_reduceProgram);
+			glUniform1i(m_reduceUniforms.count, solution.count);
+			glUniform1i(m_reduceUniforms.stage, (GLint)stage);
+			glDispatchCompute(1, 1, 1);
+			glMemoryBarrier(barrier);
+		}
+	}
+
+	void BiCGStab::update()
+	{
+		m_query.start();
+		for (auto& handle : m_domainStorage) {
+			auto& domain   = m_domainStorage.get(handle);
+			auto& solution = m_solutionStorage.get(handle);
+			auto& config   = m_configStorage.get(handle);
+
+			// uniforms are the state of the program, they survive switches to the reduce program
+			glUseProgram(m_program);
+			solution.bind();
+			m_gridUniforms.set(solution.x);
+			m_convectionUniforms.set(solution.convection);
+			glUniform1f(m_uniforms.hx, domain.hx);
+			glUniform1f(m_uniforms.hy, domain.hy);
+
+			for (uint i = 0; i < config.itersPerUpdate; i++) {
+				dispatch(domain, solution, Stage::V);
+				dispatch(domain, solution, Stage::T);
+				dispatch(domain, solution, Stage::X);
+				dispatch(domain, solution, Stage::P);
+			}
+		}
+		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
+	}
+
+	GLuint64 BiCGStab::elapsed() const
+	{
+		return m_query.elapsed();
+	}
+
+	f64 BiCGStab::elapsedMean() const
+	{
+		return m_query.elapsedMean();
+	}
+
+	f32 BiCGStab::residual(Handle handle) const
+	{
+		f32 result{};
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+		glGetNamedBufferSubData(m_solutionStorage.get(handle).scalars.id, offsetof(Scalars, residual), sizeof(f32), &result);
+		return result;
+	}
+}
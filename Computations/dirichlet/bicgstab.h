@@ -0,0 +1,152 @@
+#pragma once
+
+#include <core.h>
+#include <handle.h>
+#include <storage.h>
+#include <handle-pool.h>
+
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+#include "time_query.h"
+#include "grid_storage.h"
+#include "convection.h"
+#include "dirichlet_cfg.h"
+#include "dirichlet_handle.h"
+#include "resource_provider.h"
+#include "dirichlet_dataaabb2d.h"
+#include "dirichlet_domainaabb2d.h"
+
+namespace dir2d
+{
+	// bindings of the buffers, must match BICGSTAB_*_BINDING of shaders/bicgstab.glsl
+	constexpr uint bicgstab_partials_binding = 8;
+	constexpr uint bicgstab_scalars_binding  = 9;
+
+	// krylov solver of the non-symmetric convection-diffusion problems div(grad(u)) + b * grad(u) = f(see shaders/convection.glsl),
+	// poisson problems are solved if program is built without _CONVECTION
+	// matrix-free: the stencil is applied by the program, dot products are fused into its stages and reduced on gpu,
+	// so an iteration is 4 dispatches of the program and 3 dispatches of the reduce program without readbacks
+	// one iteration per update, handle is initialized(r = f - Ax) on creation
+	// scalar problems of the whole box with constant coefficient and dirichlet edges only
+	class BiCGStab
+		: public HandlePool
+		, public SmartHandleProvider
+		, public IResourceProvider
+	{
+	public:
+		// stages of the program, must match BICGSTAB_* of shaders/bicgstab.glsl
+		enum class Stage : i32
+		{
+			Init, // r = f - Ax, rh = r, p = r
+			V,    // v = Ap
+			T,    // s = r - alpha v, t = As
+			X,    // x += alpha p + omega s, r = s - omega t
+			P,    // p = r + beta (p - omega v), has no partials
+		};
+
+		// scalars of the method, must match ScalarsBlock of shaders/bicgstab.glsl
+		struct Scalars
+		{
+			f32 rho{};
+			f32 alpha{};
+			f32 omega{};
+			f32 beta{};
+			f32 residual{}; // 2-norm of f - Ax
+		};
+
+		struct Uniforms
+		{
+			Uniforms(gl::Id program);
+
+			void setup(gl::Id program);
+			bool valid() const;
+
+			GLint stage{-1};
+			GLint hx{-1};
+			GLint hy{-1};
+		};
+
+		struct ReduceUniforms
+		{
+			ReduceUniforms(gl::Id program);
+
+			void setup(gl::Id program);
+			bool valid() const;
+
+			GLint count{-1};
+			GLint stage{-1};
+		};
+
+		struct Solution
+		{
+			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, i32 partials);
+
+			gl::Id texture() const;
+			void sync() const;
+			void bind() const;
+
+			GridStorage x; // solution
+			GridStorage r, rh, p, v, s, t; // vectors of the method, zero at the edges
+			GridStorage f; // f - see problem description
+			gl::Buffer partials; // vec2 per workgroup
+			gl::Buffer scalars;  // Scalars
+			i32 count{}; // number of partials
+			Convection convection; // non-zero only for convection programs
+		};
+
+	public:
+		// reduceProgram - bicgstab_reduce program, sums the partials and updates the scalars
+		BiCGStab(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id reduceProgram);
+
+		~BiCGStab() = default;
+
+		BiCGStab(const BiCGStab&) = delete;
+		BiCGStab& operator = (const BiCGStab&) = delete;
+
+		BiCGStab(BiCGStab&&) noexcept = delete;
+		BiCGStab& operator = (BiCGStab&&) noexcept = delete;
+
+	public:
+		Handle create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+		SmartHandle createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+
+	public: // IResourceProvider
+		bool valid(Handle handle) const override;
+		void destroy(Handle handle) override;
+
+		const DomainAabb2D& domain(Handle handle) const override;
+		gl::Id texture(Handle handle) const override;
+
+	public:
+		void update();
+
+		GLuint64 elapsed() const;
+		f64 elapsedMean() const;
+
+		// 2-norm of f - Ax after the last update, waits for the gpu
+		// not comparable with max |u_new - u_old| of the relaxation systems
+		f32 residual(Handle handle) const;
+
+	private:
+		// solution must be bound, changes current program
+		void dispatch(const DomainAabb2D& domain, const Solution& solution, Stage stage) const;
+
+	private:
+		uint m_workgroupSizeX{};
+		uint m_workgroupSizeY{};
+		StorageType m_storage{};
+
+		gl::Id m_program;
+		gl::Id m_reduceProgram;
+		Uniforms m_uniforms;
+		ReduceUniforms m_reduceUniforms;
+		GridUniforms m_gridUniforms;
+		ConvectionUniforms m_convectionUniforms;
+		TimeQuery m_query;
+
+		Storage<DomainAabb2D> m_domainStorage;
+		Storage<Solution>     m_solutionStorage;
+		Storage<UpdateParams> m_configStorage;
+	};
+}
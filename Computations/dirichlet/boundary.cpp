@@ -0,0 +1,41 @@
+#include "boundary.h"
+
+#include <gl-cxx/gl-header.h>
+
+namespace dir2d
+{
+	BoundaryUniforms::BoundaryUniforms(gl::Id program)
+	{
+		setup(program);
+	}
+
+	void BoundaryUniforms::setup(gl::Id program)
+	{
+		type  = glGetUniformLocation(program, "boundaryType");
+		robin = glGetUniformLocation(program, "boundaryRobinA");
+	}
+
+	// a is passed for robin edges only
+	void BoundaryUniforms::set(const BoundaryConditions& conditions) const
+	{
+		if (type == -1) {
+			return;
+		}
+
+		GLint types[BoundaryConditions::edges];
+		GLfloat a[BoundaryConditions::edges];
+		for (i32 edge = 0; edge < BoundaryConditions::edges; edge++) {
+			types[edge] = (GLint)conditions.type[edge];
+			a[edge] = (conditions.type[edge] == BoundaryType::Robin ? conditions.a[edge] : 0.0f);
+		}
+		glUniform4iv(type, 1, types);
+		if (robin != -1) {
+			glUniform4fv(robin, 1, a);
+		}
+	}
+
+	bool BoundaryUniforms::enabled() const
+	{
+		return type != -1;
+	}
+}
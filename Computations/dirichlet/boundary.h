@@ -0,0 +1,26 @@
+#pragma once
+
+#include <core.h>
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+#include "dirichlet_dataaabb2d.h"
+
+namespace dir2d
+{
+	// uniforms of programs updating neumann and robin edges(_BOUNDARY), locations are -1 otherwise
+	struct BoundaryUniforms
+	{
+		BoundaryUniforms() = default;
+		BoundaryUniforms(gl::Id program);
+
+		void setup(gl::Id program);
+		void set(const BoundaryConditions& conditions) const;
+
+		// false if program keeps all edges, only dirichlet problems are accepted then
+		bool enabled() const;
+
+		GLint type{-1};
+		GLint robin{-1};
+	};
+}
@@ -39,44 +39,55 @@ namespace dir2d
 		const DomainAabb2D& domain,
 		const DataAabb2D& data,
 		uint workgroupSizeX,
-		uint workgroupSizeY)
+		uint workgroupSizeY,
+		StorageType storage)
 	{
 		i32 xVar = domain.xSplit + 1;
 		i32 yVar = domain.ySplit + 1;
 
-		solution.s = gl::create_texture(xVar, yVar, GL_R32F);
-		glTextureSubImage2D(solution.s.id, 0, 0, 0, xVar, yVar, GL_RED, GL_FLOAT, data.solution.get());
+		GridStorage::create(solution.s, storage, xVar, yVar, data.solution.get());
 
-		solution.f = gl::create_texture(xVar, yVar, GL_R32F);
-		glTextureSubImage2D(solution.f.id, 0, 0, 0, xVar, yVar, GL_RED, GL_FLOAT, data.f.get());
+		GridStorage::create(solution.f, storage, xVar, yVar, data.f.get());
 
 		return solution.s.valid() && solution.f.valid();
 	}
 
 	gl::Id ChaoticSmtm::Solution::texture() const
 	{
-		return s.id;
+		return s.texture();
+	}
+
+	void ChaoticSmtm::Solution::sync() const
+	{
+		s.sync();
 	}
 
 
 	// method
-	ChaoticSmtm::ChaoticSmtm(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1)
+	ChaoticSmtm::ChaoticSmtm(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1, StorageType storage)
 		: m_workgroupSizeX{workgroupSizeX}
 		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
 		, m_programSt0{programSt0}
 		, m_programSt1{programSt1}
 		, m_uniformsSt0(m_programSt0)
 		, m_uniformsSt1(m_programSt1)
+		, m_gridUniformsSt0(m_programSt0)
+		, m_gridUniformsSt1(m_programSt1)
 	{
 		Uniforms dummy(m_programSt1); // dummys check, no need for second uniforms struct 'cause uniform set is the same in both stages
 	}
 
 	Handle ChaoticSmtm::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
 	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || !data.convection.none()) {
+			return null_handle;
+		}
+
 		Handle handle = acquire();
 
 		Solution solution;
-		if (!Solution::create(solution, domain, data, m_workgroupSizeX, m_workgroupSizeY))
+		if (!Solution::create(solution, domain, data, m_workgroupSizeX, m_workgroupSizeY, m_storage))
 		{
 			return null_handle;
 		}
@@ -141,8 +152,9 @@ namespace dir2d
 			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
 			auto stage0Workgroups = count_stage_workgroups(numWorkgroupsX, numWorkgroupsY, Stage::Stage0);
 
-			glBindImageTexture(IMGS, solution.s.id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMGF, solution.f.id, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+			solution.s.bind(IMGS, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			m_gridUniformsSt0.set(solution.f);
 
 			glUniform1f(m_uniformsSt0.hx, domain.hx);
 			glUniform1f(m_uniformsSt0.hy, domain.hy);
@@ -152,7 +164,7 @@ namespace dir2d
 			glDispatchCompute(stage0Workgroups, 1, 1);
 		}
 		// TODO : test with and without barrier
-		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+		glMemoryBarrier(get_storage_barrier(m_storage));
 		m_querySt0.end();
 
 
@@ -172,8 +184,9 @@ namespace dir2d
 			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
 			auto stage1Workgroups = count_stage_workgroups(numWorkgroupsX, numWorkgroupsY, Stage::Stage1);
 
-			glBindImageTexture(IMGS, solution.s.id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMGF, solution.f.id, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+			solution.s.bind(IMGS, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			m_gridUniformsSt1.set(solution.f);
 
 			glUniform1f(m_uniformsSt1.hx, domain.hx);
 			glUniform1f(m_uniformsSt1.hy, domain.hy);
@@ -183,8 +196,12 @@ namespace dir2d
 			glDispatchCompute(stage1Workgroups, 1, 1);
 		}
 		// TODO : test with and without barrier
-		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+		glMemoryBarrier(get_storage_barrier(m_storage));
 		m_querySt1.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
 	}
 
 	GLuint64 ChaoticSmtm::elapsed() const
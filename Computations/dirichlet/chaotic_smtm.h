@@ -30,16 +30,18 @@ namespace dir2d
 				const DomainAabb2D& domain,
 				const DataAabb2D& data,
 				uint workgroupSizeX,
-				uint workgroupSizeY);
+				uint workgroupSizeY,
+				StorageType storage);
 
 			gl::Id texture() const;
+			void sync() const;
 
-			gl::Texture s; // solution
-			gl::Texture f; // f-function from description
+			GridStorage s; // solution
+			GridStorage f; // f-function from description
 		};
 
 	public:
-		ChaoticSmtm(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1);
+		ChaoticSmtm(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1, StorageType storage);
 
 		~ChaoticSmtm() = default;
 
@@ -69,11 +71,14 @@ namespace dir2d
 	private:
 		uint m_workgroupSizeX{};
 		uint m_workgroupSizeY{};
+		StorageType m_storage{};
 
 		gl::Id m_programSt0;
 		gl::Id m_programSt1;
 		Uniforms m_uniformsSt0;
 		Uniforms m_uniformsSt1;
+		GridUniforms m_gridUniformsSt0;
+		GridUniforms m_gridUniformsSt1;
 		TimeQuery m_querySt0;
 		TimeQuery m_querySt1;
 
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "red_black.h"
+
+namespace dir2d
+{
+	// both smtm stages in a single dispatch: stage 1 tiles wait for their stage 0 neighbours on per-tile flags
+	class ChaoticSmtmDf
+		: HandlePool
+		, SmartHandleProvider
+		, IResourceProvider
+	{
+	public:
+		struct Uniforms
+		{
+			Uniforms(gl::Id program);
+
+			void setup(gl::Id program);
+			bool valid() const;
+
+			GLint hx{-1};
+			GLint hy{-1};
+			GLint numWorkgroupsX{-1};
+			GLint numWorkgroupsY{-1};
+			GLint stage0Workgroups{-1};
+		};
+
+		struct Solution
+		{
+			static bool create(
+				Solution& solution,
+				const DomainAabb2D& domain,
+				const DataAabb2D& data,
+				uint workgroupSizeX,
+				uint workgroupSizeY,
+				StorageType storage);
+
+			gl::Id texture() const;
+			void sync() const;
+
+			GridStorage s; // solution
+			GridStorage f; // f-function from description
+			gl::Buffer dataflow; // ticket counter + readiness flag per tile
+		};
+
+	public:
+		ChaoticSmtmDf(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage);
+
+		~ChaoticSmtmDf() = default;
+
+		ChaoticSmtmDf(const ChaoticSmtmDf&) = delete;
+		ChaoticSmtmDf& operator = (const ChaoticSmtmDf&) = delete;
+
+		ChaoticSmtmDf(ChaoticSmtmDf&&) noexcept = delete;
+		ChaoticSmtmDf& operator = (ChaoticSmtmDf&&) noexcept = delete;
+
+	public:
+		Handle create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+		SmartHandle createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+
+	public: // IResourceProvider
+		bool valid(Handle handle) const override;
+		void destroy(Handle handle) override;
+
+		const DomainAabb2D& domain(Handle handle) const override;
+		gl::Id texture(Handle handle) const override;
+
+	public:
+		void update();
+
+		GLuint64 elapsed() const;
+		f64 elapsedMean() const;
+
+	private:
+		uint m_workgroupSizeX{};
+		uint m_workgroupSizeY{};
+		StorageType m_storage{};
+
+		gl::Id m_program;
+		Uniforms m_uniforms;
+		GridUniforms m_gridUniforms;
+		TimeQuery m_query;
+
+		Storage<DomainAabb2D> m_domainStorage;
+		Storage<Solution>     m_solutionStorage;
+		Storage<UpdateParams> m_configStorage;
+	};
+}
@@ -33,39 +33,48 @@ namespace dir2d
 
 
 	// solution data
-	bool ChaoticTiled::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data)
+	bool ChaoticTiled::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage)
 	{
 		int xVars = domain.xSplit + 1;
 		int yVars = domain.ySplit + 1;
 
-		solution.s = gl::create_texture(xVars, yVars, GL_R32F);
-		glTextureSubImage2D(solution.s.id, 0, 0, 0, xVars, yVars, GL_RED, GL_FLOAT, data.solution.get()); // boundary conditions
-		solution.f = gl::create_texture(xVars, yVars, GL_R32F);
-		glTextureSubImage2D(solution.f.id, 0, 0, 0, xVars, yVars, GL_RED, GL_FLOAT, data.f.get());
+		GridStorage::create(solution.s, storage, xVars, yVars, data.solution.get()); // boundary conditions
+		GridStorage::create(solution.f, storage, xVars, yVars, data.f.get());
 
 		return solution.s.valid() && solution.f.valid();
 	}
 
 	gl::Id ChaoticTiled::Solution::texture() const
 	{
-		return s.id;
+		return s.texture();
+	}
+
+	void ChaoticTiled::Solution::sync() const
+	{
+		s.sync();
 	}
 
 
 	// method
-	ChaoticTiled::ChaoticTiled(uint workgroupSizeX, uint workgroupSizeY, gl::Id program)
+	ChaoticTiled::ChaoticTiled(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage)
 		: m_workgroupSizeX{workgroupSizeX}
 		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
 		, m_program{program}
 		, m_uniforms(m_program)
+		, m_gridUniforms(m_program)
 	{}
 
 	Handle ChaoticTiled::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
 	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || !data.convection.none()) {
+			return null_handle;
+		}
+
 		Handle handle = acquire();
 
 		Solution solution;
-		if (!Solution::create(solution, domain, data)) {
+		if (!Solution::create(solution, domain, data, m_storage)) {
 			return null_handle;
 		}
 
@@ -120,8 +129,9 @@ namespace dir2d
 			auto& solution = m_solutionStorage.get(handle);
 			auto& config = m_configStorage.get(handle);
 
-			glBindImageTexture(IMGS, solution.s.id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMGF, solution.f.id, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+			solution.s.bind(IMGS, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			m_gridUniforms.set(solution.f);
 
 			glUniform1f(m_uniforms.hx, domain.hx);
 			glUniform1f(m_uniforms.hy, domain.hy);
@@ -130,10 +140,14 @@ namespace dir2d
 			for (i32 i = 0; i < config.itersPerUpdate; i++) {
 				glDispatchCompute(numWorkgroupsX, numWorkgroupsY, 1);
 				// TODO : check with barrier and without
-				glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+				glMemoryBarrier(get_storage_barrier(m_storage));
 			}
 		}
 		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
 	}
 
 	GLuint64 ChaoticTiled::elapsed() const
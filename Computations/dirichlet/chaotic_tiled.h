@@ -9,6 +9,7 @@
 #include <gl-cxx/gl-types.h>
 
 #include "time_query.h"
+#include "grid_storage.h"
 #include "dirichlet_cfg.h"
 #include "dirichlet_handle.h"
 #include "resource_provider.h"
@@ -36,16 +37,17 @@ namespace dir2d
 
 		struct Solution
 		{
-			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data);
+			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage);
 
 			gl::Id texture() const;
+			void sync() const;
 
-			gl::Texture s; // s = solution
-			gl::Texture f; // f - see problem description
+			GridStorage s; // s = solution
+			GridStorage f; // f - see problem description
 		};
 
 	public:
-		ChaoticTiled(uint workgroupSizeX, uint workgroupSizeY, gl::Id program);
+		ChaoticTiled(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage);
 
 		~ChaoticTiled() = default;
 
@@ -75,9 +77,11 @@ namespace dir2d
 	private:
 		uint m_workgroupSizeX{};
 		uint m_workgroupSizeY{};
+		StorageType m_storage{};
 
 		gl::Id m_program;
 		Uniforms m_uniforms;
+		GridUniforms m_gridUniforms;
 		TimeQuery m_query;
 
 		Storage<DomainAabb2D> m_domainStorage;
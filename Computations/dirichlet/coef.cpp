@@ -0,0 +1,13 @@
+#include "coef.h"
+
+#include <gl-cxx/gl-header.h>
+
+namespace dir2d
+{
+	// k is either an image uniform or a buffer block
+	bool program_has_coef(gl::Id program)
+	{
+		return glGetProgramResourceIndex(program, GL_UNIFORM, "k") != GL_INVALID_INDEX
+			|| glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, "CoefBlock") != GL_INVALID_INDEX;
+	}
+}
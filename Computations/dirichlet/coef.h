@@ -0,0 +1,11 @@
+#pragma once
+
+#include <core.h>
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+namespace dir2d
+{
+	// true if program solves div(k grad u) = f with k grid(_COEF), k = 1 otherwise
+	bool program_has_coef(gl::Id program);
+}
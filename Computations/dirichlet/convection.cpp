@@ -0,0 +1,28 @@
+#include "convection.h"
+
+#include <gl-cxx/gl-header.h>
+
+namespace dir2d
+{
+	ConvectionUniforms::ConvectionUniforms(gl::Id program)
+	{
+		setup(program);
+	}
+
+	void ConvectionUniforms::setup(gl::Id program)
+	{
+		velocity = glGetUniformLocation(program, "velocity");
+	}
+
+	void ConvectionUniforms::set(const Convection& convection) const
+	{
+		if (velocity != -1) {
+			glUniform2fv(velocity, 1, convection.b);
+		}
+	}
+
+	bool ConvectionUniforms::enabled() const
+	{
+		return velocity != -1;
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <core.h>
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+#include "dirichlet_dataaabb2d.h"
+
+namespace dir2d
+{
+	// uniform of programs solving convection-diffusion problems(_CONVECTION), location is -1 otherwise
+	struct ConvectionUniforms
+	{
+		ConvectionUniforms() = default;
+		ConvectionUniforms(gl::Id program);
+
+		void setup(gl::Id program);
+		void set(const Convection& convection) const;
+
+		// false if program solves poisson problems only, convective problems are rejected then
+		bool enabled() const;
+
+		GLint velocity{-1};
+	};
+}
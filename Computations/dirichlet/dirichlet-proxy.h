@@ -2,24 +2,28 @@
 
 #include <type_traits>
 
+#include <gl-cxx/gl-res.h>
 #include <gl-cxx/gl-types.h>
 #include <dirichlet/dirichlet_cfg.h>
 #include <dirichlet/dirichlet_handle.h>
 #include <dirichlet/dirichlet_function.h>
 #include <dirichlet/dirichlet_dataaabb2d.h>
 #include <dirichlet/dirichlet_domainaabb2d.h>
+#include <dirichlet/dirichlet_dataaabb3d.h>
+#include <dirichlet/dirichlet_domainaabb3d.h>
 
 namespace dir2d
 {
-	template<class T, class = void>
+	// Domain, Data - problem description the system accepts(2d by default)
+	template<class T, class Domain = DomainAabb2D, class Data = DataAabb2D, class = void>
 	struct is_dirichlet_system : std::false_type 
 	{};
 
-	template<class T>
-	struct is_dirichlet_system<T, 
+	template<class T, class Domain, class Data>
+	struct is_dirichlet_system<T, Domain, Data,
 		std::enable_if_t<
-			std::is_invocable_r_v<Handle, decltype(&T::create), T*, const DomainAabb2D&, const DataAabb2D&, const UpdateParams&>
-			&& std::is_invocable_r_v<SmartHandle, decltype(&T::createSmart), T*, const DomainAabb2D&, const DataAabb2D&, const UpdateParams&>
+			std::is_invocable_r_v<Handle, decltype(&T::create), T*, const Domain&, const Data&, const UpdateParams&>
+			&& std::is_invocable_r_v<SmartHandle, decltype(&T::createSmart), T*, const Domain&, const Data&, const UpdateParams&>
 			&& std::is_invocable_r_v<void, decltype(&T::destroy), T*, Handle>
 			&& std::is_invocable_r_v<void, decltype(&T::update), T*>
 			&& std::is_invocable_r_v<GLuint64, decltype(&T::elapsed), T*>
@@ -28,21 +32,57 @@ namespace dir2d
 	> : std::true_type
 	{};
 
+	template<class T, class Domain = DomainAabb2D, class Data = DataAabb2D>
+	constexpr bool is_dirichlet_system_v = is_dirichlet_system<T, Domain, Data>::value;
+
+	// residual is optional, not every system tracks it
+	template<class T, class = void>
+	struct has_residual : std::false_type
+	{};
+
 	template<class T>
-	constexpr bool is_dirichlet_system_v = is_dirichlet_system<T>::value;
+	struct has_residual<T,
+		std::enable_if_t<
+			std::is_invocable_r_v<f32, decltype(&T::residual), T*, Handle>
+		>
+	> : std::true_type
+	{};
+
+	template<class T>
+	constexpr bool has_residual_v = has_residual<T>::value;
+
+	// f texture is optional, only systems that solve implicit time steps expose it
+	template<class T, class = void>
+	struct has_rhs_texture : std::false_type
+	{};
 
-	class Proxy
+	template<class T>
+	struct has_rhs_texture<T,
+		std::enable_if_t<
+			std::is_invocable_r_v<gl::Id, decltype(&T::rhsTexture), T*, Handle>
+		>
+	> : std::true_type
+	{};
+
+	template<class T>
+	constexpr bool has_rhs_texture_v = has_rhs_texture<T>::value;
+
+	// type-erased system solving problems described by Domain and Data
+	template<class Domain, class Data>
+	class BasicProxy
 	{
 	public:
-		using CreateFunc = Handle(*)(void*, const DomainAabb2D&, const DataAabb2D&, const UpdateParams&);
-		using CreateSmartFunc = SmartHandle(*)(void*, const DomainAabb2D&, const DataAabb2D&, const UpdateParams&);
+		using CreateFunc = Handle(*)(void*, const Domain&, const Data&, const UpdateParams&);
+		using CreateSmartFunc = SmartHandle(*)(void*, const Domain&, const Data&, const UpdateParams&);
 		using DestroyFunc = void(*)(void*, Handle);
 		using UpdateFunc = void(*)(void*);
 		using ElapsedFunc = GLuint64(*)(void*);
 		using ElapsedMeanFunc = f64(*)(void*);
+		using ResidualFunc = f32(*)(void*, Handle);
+		using RhsTextureFunc = gl::Id(*)(void*, Handle);
 
 		template<class T>
-		Proxy(T& instance)
+		BasicProxy(T& instance)
 		{
 			store(instance);
 		}
@@ -50,15 +90,15 @@ namespace dir2d
 		template<class T>
 		void store(T& instance)
 		{
-			static_assert(is_dirichlet_system_v<T>, "T is not a dirichlet system");
+			static_assert(is_dirichlet_system_v<T, Domain, Data>, "T is not a dirichlet system");
 
 			m_instance = &instance;
 
-			m_createFunc = [] (void* inst, const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& params)
+			m_createFunc = [] (void* inst, const Domain& domain, const Data& data, const UpdateParams& params)
 			{
 				return static_cast<T*>(inst)->create(domain, data, params);
 			};
-			m_createSmartFunc = [] (void* inst, const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& params)
+			m_createSmartFunc = [] (void* inst, const Domain& domain, const Data& data, const UpdateParams& params)
 			{
 				return static_cast<T*>(inst)->createSmart(domain, data, params);
 			};
@@ -78,14 +118,30 @@ namespace dir2d
 			{
 				return static_cast<T*>(inst)->elapsedMean();
 			};
+			if constexpr (has_residual_v<T>) {
+				m_residualFunc = [] (void* inst, Handle handle)
+				{
+					return static_cast<T*>(inst)->residual(handle);
+				};
+			} else {
+				m_residualFunc = nullptr;
+			}
+			if constexpr (has_rhs_texture_v<T>) {
+				m_rhsTextureFunc = [] (void* inst, Handle handle)
+				{
+					return static_cast<T*>(inst)->rhsTexture(handle);
+				};
+			} else {
+				m_rhsTextureFunc = nullptr;
+			}
 		}
 
-		Handle create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& params)
+		Handle create(const Domain& domain, const Data& data, const UpdateParams& params)
 		{
 			return m_createFunc(m_instance, domain, data, params);
 		}
 
-		SmartHandle createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& params)
+		SmartHandle createSmart(const Domain& domain, const Data& data, const UpdateParams& params)
 		{
 			return m_createSmartFunc(m_instance, domain, data, params);
 		}
@@ -110,6 +166,24 @@ namespace dir2d
 			return m_elapsedMeanFunc(m_instance);
 		}
 
+		// negative if system doesn't track residual
+		f32 residual(Handle handle)
+		{
+			if (m_residualFunc == nullptr) {
+				return -1.0f;
+			}
+			return m_residualFunc(m_instance, handle);
+		}
+
+		// null if system doesn't expose f texture
+		gl::Id rhsTexture(Handle handle)
+		{
+			if (m_rhsTextureFunc == nullptr) {
+				return gl::null;
+			}
+			return m_rhsTextureFunc(m_instance, handle);
+		}
+
 	private:
 		void* m_instance{nullptr};
 		CreateFunc      m_createFunc{nullptr};
@@ -118,5 +192,14 @@ namespace dir2d
 		UpdateFunc      m_updateFunc{nullptr};
 		ElapsedFunc     m_elapsedFunc{nullptr};
 		ElapsedMeanFunc m_elapsedMeanFunc{nullptr};
+		ResidualFunc    m_residualFunc{nullptr};
+		RhsTextureFunc  m_rhsTextureFunc{nullptr};
 	};
+
+	using Proxy = BasicProxy<DomainAabb2D, DataAabb2D>;
+}
+
+namespace dir3d
+{
+	using Proxy = dir2d::BasicProxy<DomainAabb3D, DataAabb3D>;
 }
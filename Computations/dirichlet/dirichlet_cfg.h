@@ -9,3 +9,8 @@ namespace dir2d
 		uint itersPerUpdate{};
 	};
 }
+
+namespace dir3d
+{
+	using UpdateParams = dir2d::UpdateParams;
+}
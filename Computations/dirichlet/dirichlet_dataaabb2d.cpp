@@ -1,5 +1,7 @@
 #include "dirichlet_dataaabb2d.h"
 
+#include <algorithm>
+
 namespace dir2d
 {
 	namespace
@@ -32,29 +34,36 @@ namespace dir2d
 			}
 		}
 
+		// f is defined on the edges too: 9-point programs read it there for the rhs correction, the others never update edges
 		void initialize_f_data(DataAabb2D& data, const DomainAabb2D& domain, const Function2D& f)
 		{
 			data.f.reset(new f32[(domain.xSplit + 1) * (domain.ySplit + 1)]);
 
 			auto ptr = data.f.get();
-			for (i32 j = 0; j <= domain.xSplit; j++) {
-				*ptr++ = 0.0f;
-			}
-			for (i32 i = 1; i < domain.ySplit; i++) {
+			for (i32 i = 0; i <= domain.ySplit; i++) {
 				f32 y = domain.y0 + i * domain.hy;
-
-				*ptr++ = 0.0f;
-				for (i32 j = 1; j < domain.xSplit; j++) {
+				for (i32 j = 0; j <= domain.xSplit; j++) {
 					f32 x = domain.x0 + j * domain.hx;
 
 					*ptr++ = f(x, y);
 				}
-				*ptr++ = 0.0;
 			}
-			for (i32 j = 0; j <= domain.xSplit; j++) {
-				*ptr++ = 0.0f;
+		}
+	}
+
+	bool BoundaryConditions::dirichlet() const
+	{
+		for (i32 edge = 0; edge < edges; edge++) {
+			if (type[edge] != BoundaryType::Dirichlet) {
+				return false;
 			}
 		}
+		return true;
+	}
+
+	bool Convection::none() const
+	{
+		return b[0] == 0.0f && b[1] == 0.0f;
 	}
 
 	DataAabb2D DataAabb2D::create_data(const DomainAabb2D& domain, const Function2D& boundary, const Function2D& f)
@@ -66,4 +75,143 @@ namespace dir2d
 
 		return data;
 	}
+
+	DataAabb2D DataAabb2D::create_masked_data(const DomainAabb2D& domain, const Function2D& boundary, const Function2D& f, const Region2D& region)
+	{
+		DataAabb2D data = create_data(domain, boundary, f);
+
+		i32 width  = domain.xSplit + 1;
+		i32 height = domain.ySplit + 1;
+
+		auto inRegion = [&] (i32 i, i32 j)
+		{
+			return region(domain.x0 + j * domain.hx, domain.y0 + i * domain.hy);
+		};
+
+		data.mask.reset(new CellType[width * height]);
+		for (i32 i = 0; i < height; i++) {
+			f32 y = domain.y0 + i * domain.hy;
+			for (i32 j = 0; j < width; j++) {
+				f32 x = domain.x0 + j * domain.hx;
+
+				auto& cell = data.mask[i * width + j];
+				if (!inRegion(i, j)) {
+					cell = CellType::Outside;
+				}
+				else if (i == 0 || j == 0 || i == height - 1 || j == width - 1
+					|| !inRegion(i - 1, j) || !inRegion(i + 1, j) || !inRegion(i, j - 1) || !inRegion(i, j + 1)) {
+					cell = CellType::Dirichlet;
+					data.solution[i * width + j] = boundary(x, y);
+				}
+				else {
+					cell = CellType::Interior;
+				}
+			}
+		}
+		return data;
+	}
+
+	void DataAabb2D::set_coefficient(DataAabb2D& data, const DomainAabb2D& domain, const Function2D& k)
+	{
+		data.k.reset(new f32[(domain.xSplit + 1) * (domain.ySplit + 1)]);
+
+		auto ptr = data.k.get();
+		for (i32 i = 0; i <= domain.ySplit; i++) {
+			f32 y = domain.y0 + i * domain.hy;
+			for (i32 j = 0; j <= domain.xSplit; j++) {
+				f32 x = domain.x0 + j * domain.hx;
+
+				*ptr++ = k(x, y);
+			}
+		}
+	}
+
+	// ghost cell of the edge is u(-1) = u(1) - 2h * (a * u(0) - g), f of the edge point gets -2g/h
+	void DataAabb2D::set_boundary(DataAabb2D& data, const DomainAabb2D& domain, const BoundaryConditions& conditions, const Function2D& f, const EdgeFunction2D& flux)
+	{
+		data.boundary = conditions;
+
+		i32 width  = domain.xSplit + 1;
+		i32 height = domain.ySplit + 1;
+
+		auto dirichlet = [&] (i32 edge)
+		{
+			return conditions.type[edge] == BoundaryType::Dirichlet;
+		};
+
+		for (i32 i = 0; i < height; i++) {
+			f32 y = domain.y0 + i * domain.hy;
+			for (i32 j = 0; j < width; j++) {
+				f32 x = domain.x0 + j * domain.hx;
+
+				bool left   = (j == 0);
+				bool right  = (j == width - 1);
+				bool bottom = (i == 0);
+				bool top    = (i == height - 1);
+				if (!left && !right && !bottom && !top) {
+					continue;
+				}
+				if ((left && dirichlet(BoundaryConditions::left)) || (right && dirichlet(BoundaryConditions::right))
+					|| (bottom && dirichlet(BoundaryConditions::bottom)) || (top && dirichlet(BoundaryConditions::top))) {
+					continue;
+				}
+
+				f32 value = f(x, y);
+				if (left) {
+					value -= 2.0f * flux(BoundaryConditions::left, x, y) / domain.hx;
+				}
+				if (right) {
+					value -= 2.0f * flux(BoundaryConditions::right, x, y) / domain.hx;
+				}
+				if (bottom) {
+					value -= 2.0f * flux(BoundaryConditions::bottom, x, y) / domain.hy;
+				}
+				if (top) {
+					value -= 2.0f * flux(BoundaryConditions::top, x, y) / domain.hy;
+				}
+				data.f[i * width + j] = value;
+			}
+		}
+	}
+
+	DataAabb2D DataAabb2D::pack_data(const DomainAabb2D& domain, const DataAabb2D* data, i32 count)
+	{
+		i32 points = (domain.xSplit + 1) * (domain.ySplit + 1);
+
+		DataAabb2D packed;
+		packed.channels = max_channels;
+		packed.solution.reset(new f32[points * max_channels]{});
+		packed.f.reset(new f32[points * max_channels]{});
+		for (i32 c = 0; c < count && c < max_channels; c++) {
+			for (i32 i = 0; i < points; i++) {
+				packed.solution[i * max_channels + c] = data[c].solution[i];
+				packed.f[i * max_channels + c] = data[c].f[i];
+			}
+		}
+		bool coefficient = false;
+		for (i32 c = 0; c < count && c < max_channels; c++) {
+			coefficient = coefficient || data[c].k;
+		}
+		if (coefficient) {
+			packed.k.reset(new f32[points * max_channels]);
+			std::fill(packed.k.get(), packed.k.get() + points * max_channels, 1.0f);
+			for (i32 c = 0; c < count && c < max_channels; c++) {
+				if (data[c].k) {
+					for (i32 i = 0; i < points; i++) {
+						packed.k[i * max_channels + c] = data[c].k[i];
+					}
+				}
+			}
+		}
+		if (count > 0) {
+			packed.boundary = data[0].boundary;
+			packed.shift = data[0].shift;
+			packed.convection = data[0].convection;
+		}
+		if (count > 0 && data[0].mask) {
+			packed.mask.reset(new CellType[points]);
+			std::copy(data[0].mask.get(), data[0].mask.get() + points, packed.mask.get());
+		}
+		return packed;
+	}
 }
@@ -10,17 +10,83 @@
 
 namespace dir2d
 {
+	// type of the point of masked domain, must match CELL_* of shaders/mask.glsl
+	enum class CellType : uint8
+	{
+		Interior,  // updated
+		Dirichlet, // keeps its boundary value
+		Outside,   // keeps its value, never read by interior points
+	};
+
+	// type of the edge of the box, must match BOUNDARY_* of shaders/boundary.glsl
+	enum class BoundaryType : i32
+	{
+		Dirichlet, // u = g, edge keeps its values
+		Neumann,   // du/dn = g
+		Robin,     // du/dn + a * u = g
+	};
+
+	// conditions of the edges of the box, n is the outward normal
+	struct BoundaryConditions
+	{
+		static constexpr i32 left   = 0;
+		static constexpr i32 right  = 1;
+		static constexpr i32 bottom = 2;
+		static constexpr i32 top    = 3;
+		static constexpr i32 edges  = 4;
+
+		// all edges are dirichlet, such problems are solved by all programs
+		bool dirichlet() const;
+
+		BoundaryType type[edges]{};
+		f32 a[edges]{}; // robin edges only
+	};
+
+	// velocity b of the convection term of div(grad(u)) + b * grad(u) = f
+	struct Convection
+	{
+		// zero velocity, such problems are symmetric and solved by all programs
+		bool none() const;
+
+		f32 b[2]{}; // x, y
+	};
+
 	// Data accosiated with a given problem
-	// div(grad(u)) = f
+	// div(grad(u)) = f or div(k grad(u)) = f if coefficient is set, div(grad(u)) - shift * u = f if shift is set,
+	// div(grad(u)) + b * grad(u) = f if convection is set
 	// u(boundary) = g
 	// first coord is y(rows), second coord is x(cols) as everything is stored in row-major manner
 	// texture is 'padded' with boundary conditions
-	// stores f32 data for single-channel texture
+	// stores f32 data for single-channel texture or interleaved data of 4 problems for rgba texture
 	struct DataAabb2D
 	{
+		static constexpr i32 max_channels = 4;
+
 		static DataAabb2D create_data(const DomainAabb2D& domain, const Function2D& boundary, const Function2D& f);
 
+		// non-rectangular domain embedded in the box: points of the region having all 4 neighbours in the region are interior,
+		// the other points of the region and the edges of the box get boundary values, the rest is outside
+		static DataAabb2D create_masked_data(const DomainAabb2D& domain, const Function2D& boundary, const Function2D& f, const Region2D& region);
+
+		// point-centred coefficient k, defined at every point of the box including the edges
+		static void set_coefficient(DataAabb2D& data, const DomainAabb2D& domain, const Function2D& k);
+
+		// neumann and robin edges: points of the edges become unknowns, flux g is folded into their f,
+		// points shared with dirichlet edges keep their boundary values
+		static void set_boundary(DataAabb2D& data, const DomainAabb2D& domain, const BoundaryConditions& conditions, const Function2D& f, const EdgeFunction2D& flux);
+
+		// packs up to max_channels single-channel problems of the same domain into channels of one problem
+		// problems share the operator, so they are solved at once by the programs built with _GRID_CHANNELS 4,
+		// unused channels are zero, mask, boundary conditions, shift and convection are taken from the first problem, missing coefficients are 1
+		static DataAabb2D pack_data(const DomainAabb2D& domain, const DataAabb2D* data, i32 count);
+
 		std::unique_ptr<f32[]> solution;
-		std::unique_ptr<f32[]> f;
+		std::unique_ptr<f32[]> f;         // defined at the edges too(rhs correction of 9-point programs)
+		std::unique_ptr<CellType[]> mask; // nullptr - the whole box is the domain
+		std::unique_ptr<f32[]> k;         // nullptr - k = 1
+		BoundaryConditions boundary;      // dirichlet edges by default
+		f32 shift{};                      // 0 - poisson problem, implicit time steps of the heat equation are shifted
+		Convection convection;            // zero velocity by default, flow-driven transport problems are not symmetric
+		i32 channels{1};
 	};
 }
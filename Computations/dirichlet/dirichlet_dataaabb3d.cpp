@@ -0,0 +1,59 @@
+#include "dirichlet_dataaabb3d.h"
+
+namespace dir3d
+{
+	namespace
+	{
+		bool on_boundary(const DomainAabb3D& domain, i32 i, i32 j, i32 k)
+		{
+			return i == 0 || j == 0 || k == 0 || i == domain.ySplit || j == domain.xSplit || k == domain.zSplit;
+		}
+
+		// interior starts at zero
+		void initialize_solution_data(DataAabb3D& data, const DomainAabb3D& domain, const Function3D& boundary)
+		{
+			data.solution.reset(new f32[(domain.xSplit + 1) * (domain.ySplit + 1) * (domain.zSplit + 1)]);
+
+			auto ptr = data.solution.get();
+			for (i32 k = 0; k <= domain.zSplit; k++) {
+				f32 z = domain.z0 + k * domain.hz;
+				for (i32 i = 0; i <= domain.ySplit; i++) {
+					f32 y = domain.y0 + i * domain.hy;
+					for (i32 j = 0; j <= domain.xSplit; j++) {
+						f32 x = domain.x0 + j * domain.hx;
+
+						*ptr++ = (on_boundary(domain, i, j, k) ? boundary(x, y, z) : 0.0f);
+					}
+				}
+			}
+		}
+
+		void initialize_f_data(DataAabb3D& data, const DomainAabb3D& domain, const Function3D& f)
+		{
+			data.f.reset(new f32[(domain.xSplit + 1) * (domain.ySplit + 1) * (domain.zSplit + 1)]);
+
+			auto ptr = data.f.get();
+			for (i32 k = 0; k <= domain.zSplit; k++) {
+				f32 z = domain.z0 + k * domain.hz;
+				for (i32 i = 0; i <= domain.ySplit; i++) {
+					f32 y = domain.y0 + i * domain.hy;
+					for (i32 j = 0; j <= domain.xSplit; j++) {
+						f32 x = domain.x0 + j * domain.hx;
+
+						*ptr++ = (on_boundary(domain, i, j, k) ? 0.0f : f(x, y, z));
+					}
+				}
+			}
+		}
+	}
+
+	DataAabb3D DataAabb3D::create_data(const DomainAabb3D& domain, const Function3D& boundary, const Function3D& f)
+	{
+		DataAabb3D data;
+
+		initialize_solution_data(data, domain, boundary);
+		initialize_f_data(data, domain, f);
+
+		return data;
+	}
+}
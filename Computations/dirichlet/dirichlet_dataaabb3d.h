@@ -0,0 +1,25 @@
+#pragma once
+
+#include <core.h>
+
+#include <memory>
+
+#include "dirichlet_fwd.h"
+#include "dirichlet_function.h"
+#include "dirichlet_domainaabb3d.h"
+
+namespace dir3d
+{
+	// Data accosiated with a given problem
+	// div(grad(u)) = f
+	// u(boundary) = g
+	// stored slice by slice(z), each slice is row-major: index = (k * (ySplit + 1) + i) * (xSplit + 1) + j
+	// texture is 'padded' with boundary conditions
+	struct DataAabb3D
+	{
+		static DataAabb3D create_data(const DomainAabb3D& domain, const Function3D& boundary, const Function3D& f);
+
+		std::unique_ptr<f32[]> solution;
+		std::unique_ptr<f32[]> f;
+	};
+}
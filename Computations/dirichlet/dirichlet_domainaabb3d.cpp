@@ -0,0 +1,14 @@
+#include "dirichlet_domainaabb3d.h"
+
+namespace dir3d
+{
+	DomainAabb3D DomainAabb3D::create_domain(f32 x0, f32 x1, f32 y0, f32 y1, f32 z0, f32 z1, i32 xSplit, i32 ySplit, i32 zSplit)
+	{
+		return DomainAabb3D{x0, x1, y0, y1, z0, z1, (x1 - x0) / xSplit, (y1 - y0) / ySplit, (z1 - z0) / zSplit, xSplit, ySplit, zSplit};
+	}
+
+	dir2d::DomainAabb2D DomainAabb3D::slice_domain(const DomainAabb3D& domain)
+	{
+		return dir2d::DomainAabb2D::create_domain(domain.x0, domain.x1, domain.y0, domain.y1, domain.xSplit, domain.ySplit);
+	}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <core.h>
+
+#include "dirichlet_domainaabb2d.h"
+
+namespace dir3d
+{
+	struct DomainAabb3D
+	{
+		static DomainAabb3D create_domain(f32 x0, f32 x1, f32 y0, f32 y1, f32 z0, f32 z1, i32 xSplit, i32 ySplit, i32 zSplit);
+
+		// xy cross-section, describes the displayed slice
+		static dir2d::DomainAabb2D slice_domain(const DomainAabb3D& domain);
+
+		f32 x0{};
+		f32 x1{};
+		f32 y0{};
+		f32 y1{};
+		f32 z0{};
+		f32 z1{};
+		f32 hx{};
+		f32 hy{};
+		f32 hz{};
+		i32 xSplit{};
+		i32 ySplit{};
+		i32 zSplit{};
+	};
+}
@@ -6,4 +6,15 @@
 namespace dir2d
 {
 	using Function2D = std::function<f32(f32, f32)>;
+
+	// true if point belongs to the region
+	using Region2D = std::function<bool(f32, f32)>;
+
+	// g of the edge(see BoundaryConditions), corners get one value per edge
+	using EdgeFunction2D = std::function<f32(i32, f32, f32)>;
+}
+
+namespace dir3d
+{
+	using Function3D = std::function<f32(f32, f32, f32)>;
 }
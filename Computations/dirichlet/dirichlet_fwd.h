@@ -10,4 +10,10 @@ namespace dir2d
 
 	class SmartHandle;
 	class ScopedHandle;
-}
\ No newline at end of file
+}
+
+namespace dir3d
+{
+	struct DomainAabb3D;
+	struct DataAabb3D;
+}
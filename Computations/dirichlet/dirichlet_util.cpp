@@ -3,6 +3,9 @@
 #include <gl-cxx/gl-header.h>
 #include <gl-cxx/gl-res-util.h>
 
+#include <algorithm>
+#include <utility>
+
 namespace dir2d
 {
 	NumWorkgroups get_num_workgroups(uint splitX, uint splitY, uint workgroupSizeX, uint workgroupSizeY)
@@ -26,6 +29,19 @@ namespace dir2d
 		return 2.0 / (1.0 + std::sqrt(delta * (2.0 - delta)));
 	}
 
+	f32 compute_optimal_line_w(f32 hAlong, f32 hAcross, int alongSplit, int acrossSplit)
+	{
+		f32 ihAlong2 = 1.0 / (hAlong * hAlong);
+		f32 ihAcross2 = 1.0 / (hAcross * hAcross);
+		f32 sinAlong = std::sin(pid2 / alongSplit);
+		f32 cosAcross = std::cos(2.0 * pid2 / acrossSplit);
+
+		// spectral radius, the lowest mode across the lines against the line operator
+		f32 mu = ihAcross2 * cosAcross / (ihAcross2 + 2.0 * ihAlong2 * sinAlong * sinAlong);
+
+		return 2.0 / (1.0 + std::sqrt(1.0 - mu * mu));
+	}
+
 	gl::Buffer create_work_buffer(uint workgroupsX, uint workgroupsY, uint size, bool pad)
 	{
 		if (pad) {
@@ -46,4 +62,133 @@ namespace dir2d
 		}
 		return count;
 	}
+
+	bool is_valid_colouring(uint colours)
+	{
+		return colours == 2 || colours == 4 || colours == 9;
+	}
+
+	uint get_colour_period(uint colours)
+	{
+		if (colours == 4) {
+			return 2;
+		}
+		if (colours == 9) {
+			return 3;
+		}
+		return 0;
+	}
+
+	uint count_colour_workgroups(uint workgroupsX, uint workgroupsY, uint colours, uint colour)
+	{
+		uint period = get_colour_period(colours);
+		if (period == 0) {
+			return count_stage_workgroups(workgroupsX, workgroupsY, (Stage)colour);
+		}
+
+		uint colourX = colour % period;
+		uint colourY = colour / period;
+		if (colourX >= workgroupsX || colourY >= workgroupsY) {
+			return 0;
+		}
+		return ((workgroupsX - colourX + period - 1) / period) * ((workgroupsY - colourY + period - 1) / period);
+	}
+
+	namespace
+	{
+		WorkgroupID morton_decode(uint d, uint block)
+		{
+			WorkgroupID p{};
+			for (uint bit = 0; (1u << bit) < block; bit++) {
+				p.x |= ((d >> (2 * bit)) & 0x1) << bit;
+				p.y |= ((d >> (2 * bit + 1)) & 0x1) << bit;
+			}
+			return p;
+		}
+
+		WorkgroupID hilbert_decode(uint d, uint block)
+		{
+			WorkgroupID p{};
+			for (uint s = 1; s < block; s *= 2) {
+				uint rx = 1 & (d / 2);
+				uint ry = 1 & (d ^ rx);
+				if (ry == 0) {
+					if (rx == 1) {
+						p.x = s - 1 - p.x;
+						p.y = s - 1 - p.y;
+					}
+					std::swap(p.x, p.y);
+				}
+				p.x += s * rx;
+				p.y += s * ry;
+				d /= 4;
+			}
+			return p;
+		}
+	}
+
+	WorkgroupID swizzle_workgroup(uint id, uint workgroupsX, uint workgroupsY, Swizzle swizzle, uint block)
+	{
+		if (swizzle == Swizzle::RowMajor) {
+			return {id % workgroupsX, id / workgroupsX};
+		}
+
+		uint blockX = block;
+		uint blockY = (swizzle == Swizzle::Band ? workgroupsY : block);
+
+		// all rows of blocks but the last one are full
+		uint blockRow = id / (workgroupsX * blockY);
+		uint rowOffset = id - blockRow * workgroupsX * blockY;
+		uint height = std::min(blockY, workgroupsY - blockRow * blockY);
+
+		// all blocks of the row but the last one are full
+		uint blockCol = rowOffset / (blockX * height);
+		uint offset = rowOffset - blockCol * blockX * height;
+		uint width = std::min(blockX, workgroupsX - blockCol * blockX);
+
+		WorkgroupID local{offset % width, offset / width};
+		if (width == blockX && height == blockY) {
+			if (swizzle == Swizzle::Morton) {
+				local = morton_decode(offset, block);
+			}
+			if (swizzle == Swizzle::Hilbert) {
+				local = hilbert_decode(offset, block);
+			}
+		}
+		return {blockCol * blockX + local.x, blockRow * blockY + local.y};
+	}
+
+	uint swizzle_stage_workgroup(uint id, uint workgroupsX, uint workgroupsY, Swizzle swizzle, uint block)
+	{
+		uint pairsY = workgroupsY / 2;
+		if (id >= workgroupsX * pairsY) {
+			return id;
+		}
+
+		WorkgroupID pair = swizzle_workgroup(id, workgroupsX, pairsY, swizzle, block);
+		return pair.y * workgroupsX + pair.x;
+	}
+}
+
+namespace dir3d
+{
+	NumWorkgroups get_num_workgroups(uint splitX, uint splitY, uint splitZ, uint workgroupSizeX, uint workgroupSizeY, uint workgroupSizeZ)
+	{
+		return {splitX / workgroupSizeX + 1, splitY / workgroupSizeY + 1, splitZ / workgroupSizeZ + 1};
+	}
+
+	f32 compute_optimal_w(f32 hx, f32 hy, f32 hz, int xSplit, int ySplit, int zSplit)
+	{
+		f32 ihxhx = 1.0 / (hx * hx);
+		f32 ihyhy = 1.0 / (hy * hy);
+		f32 ihzhz = 1.0 / (hz * hz);
+		f32 sinx = std::sin(pid2 / xSplit);
+		f32 siny = std::sin(pid2 / ySplit);
+		f32 sinz = std::sin(pid2 / zSplit);
+
+		// 1 - spectral radius
+		f32 delta = 2.0 * (ihxhx * sinx * sinx + ihyhy * siny * siny + ihzhz * sinz * sinz) / (ihxhx + ihyhy + ihzhz);
+
+		return 2.0 / (1.0 + std::sqrt(delta * (2.0 - delta)));
+	}
 }
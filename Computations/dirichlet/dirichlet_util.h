@@ -17,6 +17,9 @@ namespace dir2d
 
 	f32 compute_optimal_w(f32 hx, f32 hy, int xSplit, int ySplit);
 
+	// sor parameter of zebra line relaxation, derived from spectral radius of line jacoby iteration, lines follow the axis of hAlong
+	f32 compute_optimal_line_w(f32 hAlong, f32 hAcross, int alongSplit, int acrossSplit);
+
 	gl::Buffer create_work_buffer(uint workgroupsX, uint workgroupsY, uint size, bool pad = true);
 
 
@@ -35,4 +38,58 @@ namespace dir2d
 	// 1 0 | 1 0 | 1
 	// 0 1 | 0 1 | 0
 	uint count_stage_workgroups(uint workgroupsX, uint workgroupsY, Stage stage);
-}
\ No newline at end of file
+
+
+	// tiles of the same colour never share an edge, colours are scheduled one after another
+	// 2 - checkerboard(same as stages), 4 - 2x2 blocks, 9 - 3x3 blocks
+	// example grid 5x5, 4 colours:
+	// 2 3 | 2 3 | 2
+	// 0 1 | 0 1 | 0
+	// -------------
+	// 2 3 | 2 3 | 2
+	// 0 1 | 0 1 | 0
+	bool is_valid_colouring(uint colours);
+
+	// tiles along an axis in one period of the pattern, 0 for checkerboard
+	uint get_colour_period(uint colours);
+
+	uint count_colour_workgroups(uint workgroupsX, uint workgroupsY, uint colours, uint colour);
+
+
+	// workgroup id remap for L2 locality, mirrors shaders/swizzle.glsl
+	// morton and hilbert remap ids inside of block x block squares(block must be a power of two),
+	// band - row-major inside of column bands block tiles wide, partial blocks are row-major
+	enum class Swizzle
+	{
+		RowMajor,
+		Morton,
+		Hilbert,
+		Band,
+	};
+
+	struct WorkgroupID
+	{
+		uint x{};
+		uint y{};
+	};
+
+	WorkgroupID swizzle_workgroup(uint id, uint workgroupsX, uint workgroupsY, Swizzle swizzle, uint block);
+
+	// remaps pairs of rows of the checkerboard stage, returns id in the numbering of count_stage_workgroups
+	uint swizzle_stage_workgroup(uint id, uint workgroupsX, uint workgroupsY, Swizzle swizzle, uint block);
+}
+
+namespace dir3d
+{
+	struct NumWorkgroups
+	{
+		uint numX{};
+		uint numY{};
+		uint numZ{};
+	};
+
+	NumWorkgroups get_num_workgroups(uint splitX, uint splitY, uint splitZ, uint workgroupSizeX, uint workgroupSizeY, uint workgroupSizeZ);
+
+	// sor parameter of the 7-point operator, derived from spectral radius of jacoby iteration
+	f32 compute_optimal_w(f32 hx, f32 hy, f32 hz, int xSplit, int ySplit, int zSplit);
+}
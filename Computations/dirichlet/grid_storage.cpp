@@ -0,0 +1,154 @@
+#include "grid_storage.h"
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include <vector>
+#include <algorithm>
+
+namespace dir2d
+{
+	namespace
+	{
+		i32 align_up(i32 value, i32 alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		i32 align_pitch(i32 width)
+		{
+			return align_up(width, grid_pitch_alignment);
+		}
+
+		GLenum get_internal_format(i32 channels)
+		{
+			return (channels == 4 ? GL_RGBA32F : GL_R32F);
+		}
+
+		GLenum get_pixel_format(i32 channels)
+		{
+			return (channels == 4 ? GL_RGBA : GL_RED);
+		}
+
+		// ghost cells and padding are zero, sizes are measured in points
+		gl::Buffer create_pitched_buffer(i32 width, i32 height, i32 pitch, i32 rows, i32 ghost, i32 channels, const f32* data)
+		{
+			std::vector<f32> pitched(pitch * rows * channels, 0.0f);
+			if (data) {
+				for (i32 i = 0; i < height; i++) {
+					std::copy(data + i * width * channels, data + (i + 1) * width * channels, pitched.begin() + ((i + ghost) * pitch + ghost) * channels);
+				}
+			}
+			return gl::create_storage_buffer(pitched.size() * sizeof(f32), GL_DYNAMIC_STORAGE_BIT, pitched.data());
+		}
+	}
+
+	// grid storage
+	bool GridStorage::create(GridStorage& grid, StorageType type, i32 width, i32 height, const f32* data, i32 ghost, i32 alignX, i32 alignY, i32 channels)
+	{
+		grid.channels = channels;
+		grid.type   = type;
+		grid.width  = width;
+		grid.height = height;
+		grid.pitch  = width;
+		grid.rows   = height;
+		grid.ghost  = 0;
+		if (type == StorageType::Buffer) { // textures are never padded
+			grid.ghost = ghost;
+			grid.pitch = align_pitch(align_up(width, alignX) + 2 * ghost);
+			grid.rows  = align_up(height, alignY) + 2 * ghost;
+		}
+
+		grid.tex = gl::create_texture(width, height, get_internal_format(channels));
+		if (data) {
+			glTextureSubImage2D(grid.tex.id, 0, 0, 0, width, height, get_pixel_format(channels), GL_FLOAT, data);
+		}
+		else {
+			glClearTexImage(grid.tex.id, 0, get_pixel_format(channels), GL_FLOAT, nullptr);
+		}
+
+		if (type == StorageType::Buffer) {
+			grid.buffer = create_pitched_buffer(width, height, grid.pitch, grid.rows, grid.ghost, channels, data);
+			return grid.tex.valid() && grid.buffer.valid();
+		}
+		return grid.tex.valid();
+	}
+
+	void GridStorage::bind(uint binding, GLenum access) const
+	{
+		if (type == StorageType::Buffer) {
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer.id);
+		}
+		else {
+			glBindImageTexture(binding, tex.id, 0, GL_FALSE, 0, access, get_internal_format(channels));
+		}
+	}
+
+	void GridStorage::clear()
+	{
+		if (type == StorageType::Buffer) {
+			glClearNamedBufferData(buffer.id, GL_R32F, GL_RED, GL_FLOAT, nullptr);
+		}
+		glClearTexImage(tex.id, 0, get_pixel_format(channels), GL_FLOAT, nullptr);
+	}
+
+	void GridStorage::sync() const
+	{
+		if (type != StorageType::Buffer) {
+			return;
+		}
+
+		glMemoryBarrier(GL_PIXEL_BUFFER_BARRIER_BIT);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.id);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, pitch);
+		glPixelStorei(GL_UNPACK_SKIP_PIXELS, ghost);
+		glPixelStorei(GL_UNPACK_SKIP_ROWS, ghost);
+		glTextureSubImage2D(tex.id, 0, 0, 0, width, height, get_pixel_format(channels), GL_FLOAT, nullptr);
+		glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+		glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, gl::null);
+	}
+
+	gl::Id GridStorage::texture() const
+	{
+		return tex.id;
+	}
+
+	bool GridStorage::valid() const
+	{
+		return tex.valid() && (type != StorageType::Buffer || buffer.valid());
+	}
+
+
+	// grid uniforms
+	GridUniforms::GridUniforms(gl::Id program)
+	{
+		setup(program);
+	}
+
+	void GridUniforms::setup(gl::Id program)
+	{
+		extent = glGetUniformLocation(program, "gridExtent");
+		pitch  = glGetUniformLocation(program, "gridPitch");
+	}
+
+	void GridUniforms::set(const GridStorage& grid) const
+	{
+		if (extent != -1) {
+			glUniform2i(extent, grid.width, grid.height);
+		}
+		if (pitch != -1) {
+			glUniform1i(pitch, grid.pitch);
+		}
+	}
+
+
+	GLbitfield get_storage_barrier(StorageType type)
+	{
+		if (type == StorageType::Buffer) {
+			return GL_SHADER_STORAGE_BARRIER_BIT;
+		}
+		return GL_TEXTURE_FETCH_BARRIER_BIT;
+	}
+}
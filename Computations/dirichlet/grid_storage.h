@@ -0,0 +1,63 @@
+#pragma once
+
+#include <core.h>
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+namespace dir2d
+{
+	// where grid values live on gpu, must match _STORAGE_SSBO macro of the programs
+	enum class StorageType
+	{
+		Texture, // r32f image2D
+		Buffer,  // std430 float array with explicit pitch
+	};
+
+	// row pitch of buffer storage is padded to this amount of values (128 bytes)
+	constexpr i32 grid_pitch_alignment = 32;
+
+	// f32 grid, stored in a row-major manner
+	// grid has either 1(r32f) or 4(rgba32f, must match _GRID_CHANNELS macro of the programs) interleaved channels
+	// texture storage: tex is used both for computations and display
+	// buffer storage: buffer is used for computations, tex is a display copy updated with sync()
+	// buffer can be padded: size is aligned up to alignX x alignY and ghost layers are added on each side,
+	// value (0, 0) lives at (ghost, ghost), must match _STORAGE_GHOST macro of the programs
+	struct GridStorage
+	{
+		static bool create(GridStorage& grid, StorageType type, i32 width, i32 height, const f32* data, i32 ghost = 0, i32 alignX = 1, i32 alignY = 1, i32 channels = 1);
+
+		void bind(uint binding, GLenum access) const;
+		void clear();
+		void sync() const;
+
+		gl::Id texture() const;
+		bool valid() const;
+
+		gl::Texture tex;
+		gl::Buffer buffer;
+
+		StorageType type{StorageType::Texture};
+		i32 width{};
+		i32 height{};
+		i32 pitch{};
+		i32 rows{};  // allocated rows
+		i32 ghost{}; // ghost layers on each side
+		i32 channels{1};
+	};
+
+	// uniforms required only by buffer storage, locations are -1 otherwise
+	struct GridUniforms
+	{
+		GridUniforms() = default;
+		GridUniforms(gl::Id program);
+
+		void setup(gl::Id program);
+		void set(const GridStorage& grid) const;
+
+		GLint extent{-1};
+		GLint pitch{-1};
+	};
+
+	// barrier that has to be issued between dependent dispatches
+	GLbitfield get_storage_barrier(StorageType type);
+}
@@ -0,0 +1,56 @@
+#include "grid_storage_3d.h"
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+namespace dir3d
+{
+	bool VolumeStorage::create(VolumeStorage& volume, i32 width, i32 height, i32 depth, const f32* data, bool display)
+	{
+		volume.width  = width;
+		volume.height = height;
+		volume.depth  = depth;
+
+		volume.tex = gl::create_texture_3d(width, height, depth, GL_R32F);
+		if (data) {
+			glTextureSubImage3D(volume.tex.id, 0, 0, 0, 0, width, height, depth, GL_RED, GL_FLOAT, data);
+		}
+		else {
+			glClearTexImage(volume.tex.id, 0, GL_RED, GL_FLOAT, nullptr);
+		}
+
+		if (display) {
+			volume.slice = gl::create_texture(width, height, GL_R32F);
+			if (!volume.slice.valid()) {
+				return false;
+			}
+			volume.sync();
+		}
+		return volume.tex.valid();
+	}
+
+	void VolumeStorage::bind(uint binding, GLenum access) const
+	{
+		glBindImageTexture(binding, tex.id, 0, GL_TRUE, 0, access, GL_R32F);
+	}
+
+	void VolumeStorage::sync() const
+	{
+		if (!slice.valid()) {
+			return;
+		}
+
+		glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+		glCopyImageSubData(tex.id, GL_TEXTURE_3D, 0, 0, 0, depth / 2, slice.id, GL_TEXTURE_2D, 0, 0, 0, 0, width, height, 1);
+	}
+
+	gl::Id VolumeStorage::texture() const
+	{
+		return slice.id;
+	}
+
+	bool VolumeStorage::valid() const
+	{
+		return tex.valid();
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <core.h>
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+namespace dir3d
+{
+	// f32 grid stored in r32f image3D, slice by slice(z), each slice is row-major
+	// slice is a 2d display copy of the middle z-layer updated with sync(), allocated on demand
+	struct VolumeStorage
+	{
+		static bool create(VolumeStorage& volume, i32 width, i32 height, i32 depth, const f32* data, bool display = false);
+
+		void bind(uint binding, GLenum access) const;
+		void sync() const;
+
+		gl::Id texture() const; // display slice
+		bool valid() const;
+
+		gl::Texture tex;
+		gl::Texture slice;
+
+		i32 width{};
+		i32 height{};
+		i32 depth{};
+	};
+}
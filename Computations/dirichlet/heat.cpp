@@ -0,0 +1,127 @@
+#include "heat.h"
+#include "dirichlet_util.h"
+
+#include <gl-cxx/gl-header.h>
+
+#include <exception>
+
+namespace dir2d
+{
+	namespace
+	{
+		// must match shaders/heat_rhs.comp
+		constexpr uint heat_rhs_workgroup_x = 16;
+		constexpr uint heat_rhs_workgroup_y = 16;
+	}
+
+	f32 get_step_shift(const HeatStepping& stepping)
+	{
+		return (stepping.scheme == TimeScheme::BackwardEuler ? 1.0f : 2.0f) / stepping.dt;
+	}
+
+
+	// uniforms
+	ImplicitHeat::Uniforms::Uniforms(gl::Id program)
+	{
+		setup(program);
+		if (!valid()) {
+			throw std::runtime_error("Failed to get uniform locations from heat rhs program.");
+		}
+	}
+
+	void ImplicitHeat::Uniforms::setup(gl::Id program)
+	{
+		scheme = glGetUniformLocation(program, "scheme");
+		shift  = glGetUniformLocation(program, "shift");
+		hx     = glGetUniformLocation(program, "hx");
+		hy     = glGetUniformLocation(program, "hy");
+	}
+
+	bool ImplicitHeat::Uniforms::valid() const
+	{
+		return scheme != -1 && shift != -1 && hx != -1 && hy != -1;
+	}
+
+
+	// stepper
+	ImplicitHeat::ImplicitHeat(const DomainAabb2D& domain, const Function2D& boundary, const Function2D& f, const HeatStepping& stepping, gl::Id program)
+		: m_domain{domain}
+		, m_init{DataAabb2D::create_data(domain, boundary, f)}
+		, m_stepping{stepping}
+		, m_program{program}
+		, m_uniforms(m_program)
+	{
+		if (!GridStorage::create(m_f, StorageType::Texture, domain.xSplit + 1, domain.ySplit + 1, m_init.f.get())) {
+			throw std::runtime_error("Failed to create f texture of implicit time steps.");
+		}
+		m_init.shift = get_step_shift(m_stepping);
+	}
+
+	bool ImplicitHeat::step(Proxy& proxy)
+	{
+		// the only handle is created by the first step, f of the data is rewritten before the first update anyway
+		if (m_handle.empty()) {
+			SmartHandle handle = proxy.createSmart(m_domain, m_init, m_stepping.params);
+			if (handle.empty()) {
+				return false;
+			}
+
+			gl::Id rhs = proxy.rhsTexture(handle.handle());
+			if (rhs == gl::null) {
+				handle.destroy();
+				return false;
+			}
+
+			m_handle = handle;
+			m_rhs = rhs;
+			m_init = DataAabb2D{};
+		}
+
+		updateRhs();
+
+		m_elapsed = 0;
+		for (i32 i = 0; i < m_stepping.updates; i++) {
+			proxy.update();
+			m_elapsed += proxy.elapsed();
+		}
+		m_steps++;
+
+		return true;
+	}
+
+	void ImplicitHeat::updateRhs()
+	{
+		constexpr int IMGU = 0;
+		constexpr int IMGF0 = 1;
+		constexpr int IMGF = 2;
+
+		glUseProgram(m_program);
+		glUniform1i(m_uniforms.scheme, m_stepping.scheme == TimeScheme::CrankNicolson ? 1 : 0);
+		glUniform1f(m_uniforms.shift, get_step_shift(m_stepping));
+		glUniform1f(m_uniforms.hx, m_domain.hx);
+		glUniform1f(m_uniforms.hy, m_domain.hy);
+
+		glBindImageTexture(IMGU, m_handle.texture(), 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+		m_f.bind(IMGF0, GL_READ_ONLY);
+		glBindImageTexture(IMGF, m_rhs, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+
+		auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(m_domain.xSplit, m_domain.ySplit, heat_rhs_workgroup_x, heat_rhs_workgroup_y);
+		glDispatchCompute(numWorkgroupsX, numWorkgroupsY, 1);
+		glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+	}
+
+	const SmartHandle& ImplicitHeat::handle() const
+	{
+		return m_handle;
+	}
+
+	GLuint64 ImplicitHeat::elapsed() const
+	{
+		return m_elapsed;
+	}
+
+	f32 ImplicitHeat::time() const
+	{
+		return m_steps * m_stepping.dt;
+	}
+}
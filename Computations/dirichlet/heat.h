@@ -0,0 +1,99 @@
+#pragma once
+
+#include <core.h>
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+#include "dirichlet-proxy.h"
+#include "grid_storage.h"
+#include "dirichlet_cfg.h"
+#include "dirichlet_handle.h"
+#include "dirichlet_function.h"
+#include "dirichlet_dataaabb2d.h"
+#include "dirichlet_domainaabb2d.h"
+
+namespace dir2d
+{
+	// heat equation u_t = div(grad(u)) - f, its steady state is the poisson problem div(grad(u)) = f of the data
+	// boundary values don't depend on time, initial state is the interior of the solution of the data
+	enum class TimeScheme
+	{
+		BackwardEuler, // first order
+		CrankNicolson, // second order
+	};
+
+	struct HeatStepping
+	{
+		TimeScheme scheme{TimeScheme::BackwardEuler};
+		f32 dt{};      // time step
+		i32 updates{}; // updates of the system per time step
+		UpdateParams params{};
+	};
+
+	// each implicit step is a shifted problem for u^(n+1), u^n is the current solution of the handle:
+	//     backward euler - div(grad(u)) - u / dt = f - u^n / dt
+	//     crank-nicolson - div(grad(u)) - 2u / dt = 2f - 2u^n / dt - div(grad(u^n))
+	// u^n is the initial guess, so each step is warm started from the previous one
+	// shift of the step problem, it is the same for all steps
+	f32 get_step_shift(const HeatStepping& stepping);
+
+	// implicit time stepping of one problem(whole box, dirichlet edges, k = 1, single channel, texture storage)
+	// each step is solved by the system of the proxy, the system must accept shifted problems and expose its f texture
+	// one handle is kept for the whole run, f of the step is rebuilt from its solution on gpu(see shaders/heat_rhs.comp)
+	// proxy updates all handles of the system, so the system must have no other handles
+	class ImplicitHeat
+	{
+	public:
+		struct Uniforms
+		{
+			Uniforms(gl::Id program);
+
+			void setup(gl::Id program);
+			bool valid() const;
+
+			GLint scheme{-1};
+			GLint shift{-1};
+			GLint hx{-1};
+			GLint hy{-1};
+		};
+
+	public:
+		// program - heat_rhs program
+		ImplicitHeat(const DomainAabb2D& domain, const Function2D& boundary, const Function2D& f, const HeatStepping& stepping, gl::Id program);
+
+		~ImplicitHeat() = default;
+
+		ImplicitHeat(const ImplicitHeat&) = delete;
+		ImplicitHeat& operator = (const ImplicitHeat&) = delete;
+
+		ImplicitHeat(ImplicitHeat&&) noexcept = default;
+		ImplicitHeat& operator = (ImplicitHeat&&) noexcept = delete;
+
+	public:
+		// false if the system rejects the step problem or doesn't expose its f texture, the state is kept then
+		bool step(Proxy& proxy);
+
+		// handle of all steps, its texture is u^n, empty before the first step
+		const SmartHandle& handle() const;
+
+		// gpu time of all updates of the last step
+		GLuint64 elapsed() const;
+
+		f32 time() const;
+
+	private:
+		void updateRhs();
+
+	private:
+		DomainAabb2D m_domain;
+		DataAabb2D m_init; // u^0 and f, released once the handle is created
+		HeatStepping m_stepping;
+		GridStorage m_f;   // f of the heat equation
+		gl::Id m_program{};
+		Uniforms m_uniforms;
+		SmartHandle m_handle;
+		gl::Id m_rhs{};    // f texture of the handle
+		GLuint64 m_elapsed{};
+		i32 m_steps{};
+	};
+}
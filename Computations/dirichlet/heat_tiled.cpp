@@ -0,0 +1,212 @@
+#include "heat_tiled.h"
+
+#include <exception>
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include "dirichlet_util.h"
+
+namespace dir2d
+{
+	// uniforms
+	HeatTiled::Uniforms::Uniforms(gl::Id program)
+	{
+		setup(program);
+		if (!valid()) {
+			throw std::runtime_error("Failed to get uniform locations from heat program.");
+		}
+	}
+
+	void HeatTiled::Uniforms::setup(gl::Id program)
+	{
+		curr = glGetUniformLocation(program, "curr");
+		hx   = glGetUniformLocation(program, "hx");
+		hy   = glGetUniformLocation(program, "hy");
+		dt   = glGetUniformLocation(program, "dt");
+	}
+
+	bool HeatTiled::Uniforms::valid() const
+	{
+		return curr != -1 && hx != -1 && hy != -1 && dt != -1;
+	}
+
+
+	// solution data
+	bool HeatTiled::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, RhsType rhs, f32 courant)
+	{
+		int xVars = domain.xSplit + 1;
+		int yVars = domain.ySplit + 1;
+
+		solution.curr = 0;
+		for (int i = 0; i < 2; i++) {
+			GridStorage::create(solution.s[i], storage, xVars, yVars, data.solution.get()); // boundary conditions
+		}
+		if (rhs == RhsType::Grid) {
+			GridStorage::create(solution.f, storage, xVars, yVars, data.f.get());
+		}
+
+		solution.dt = courant / (2.0f / (domain.hx * domain.hx) + 2.0f / (domain.hy * domain.hy));
+
+		return solution.s[0].valid() && solution.s[1].valid() && (rhs == RhsType::Analytic || solution.f.valid());
+	}
+
+	gl::Id HeatTiled::Solution::texture() const
+	{
+		return s[curr].texture();
+	}
+
+	void HeatTiled::Solution::sync() const
+	{
+		s[curr].sync();
+	}
+
+	void HeatTiled::Solution::pingpong()
+	{
+		curr ^= 1;
+	}
+
+
+	// forward euler method
+	HeatTiled::HeatTiled(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id residualProgram, f32 courant)
+		: m_workgroupSizeX{workgroupSizeX}
+		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
+		, m_courant{courant}
+		, m_program{program}
+		, m_residualProgram{program_has_residual(program) ? residualProgram : gl::null}
+		, m_uniforms(m_program)
+		, m_gridUniforms(m_program)
+		, m_rhsUniforms(m_program)
+	{}
+
+	// scalar poisson problems of the whole box only
+	Handle HeatTiled::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || data.shift != 0.0f || !data.convection.none()) {
+			return null_handle;
+		}
+
+		Handle handle = acquire();
+
+		Solution solution;
+		if (!Solution::create(solution, domain, data, m_storage, m_rhsUniforms.type(), m_courant)) {
+			return null_handle;
+		}
+
+		if (m_residualProgram != gl::null) {
+			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			if (!ResidualStorage::create(solution.residual, numWorkgroupsX * numWorkgroupsY)) {
+				return null_handle;
+			}
+		}
+
+		m_domainStorage.emplace(handle, domain);
+		m_solutionStorage.emplace(handle, std::move(solution));
+		m_configStorage.emplace(handle, config);
+
+		return handle;
+	}
+
+	SmartHandle HeatTiled::createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		Handle handle = create(domain, data, config);
+		if (handle == null_handle) {
+			return SmartHandle{};
+		}
+		return provideHandle(handle, this);
+	}
+
+	bool HeatTiled::valid(Handle handle) const
+	{
+		return m_domainStorage.has(handle); // can check only first
+	}
+
+	void HeatTiled::destroy(Handle handle)
+	{
+		m_domainStorage.remove(handle);
+		m_solutionStorage.remove(handle);
+		m_configStorage.remove(handle);
+	}
+
+	const DomainAabb2D& HeatTiled::domain(Handle handle) const
+	{
+		return m_domainStorage.get(handle);
+	}
+
+	gl::Id HeatTiled::texture(Handle handle) const
+	{
+		return m_solutionStorage.get(handle).texture();
+	}
+
+	void HeatTiled::update()
+	{
+		constexpr int IMG0 = 0;
+		constexpr int IMG1 = 1;
+		constexpr int IMGF = 2;
+
+		glUseProgram(m_program);
+
+		m_query.start();
+		for (auto handle : m_domainStorage) {
+			auto& domain   = m_domainStorage.get(handle);
+			auto& solution = m_solutionStorage.get(handle);
+			auto& config   = m_configStorage.get(handle);
+
+			solution.s[0].bind(IMG0, GL_READ_WRITE);
+			solution.s[1].bind(IMG1, GL_READ_WRITE);
+			if (m_rhsUniforms.type() == RhsType::Grid) {
+				solution.f.bind(IMGF, GL_READ_ONLY);
+			}
+			m_gridUniforms.set(solution.s[0]);
+			m_rhsUniforms.set(domain);
+			if (m_residualProgram != gl::null) {
+				solution.residual.clear();
+				solution.residual.bind();
+			}
+
+			glUniform1f(m_uniforms.hx, domain.hx);
+			glUniform1f(m_uniforms.hy, domain.hy);
+			glUniform1f(m_uniforms.dt, solution.dt);
+
+			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			for (i32 i = 0; i < config.itersPerUpdate; i++) {
+				glUniform1i(m_uniforms.curr, solution.curr);
+				glDispatchCompute(numWorkgroupsX, numWorkgroupsY, 1);
+				glMemoryBarrier(get_storage_barrier(m_storage));
+
+				solution.pingpong();
+			}
+		}
+
+		// reduce pass of the partials accumulated by the updates
+		if (m_residualProgram != gl::null) {
+			for (auto handle : m_domainStorage) {
+				m_solutionStorage.get(handle).residual.reduce(m_residualProgram);
+			}
+		}
+		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
+	}
+
+	GLuint64 HeatTiled::elapsed() const
+	{
+		return m_query.elapsed();
+	}
+
+	f64 HeatTiled::elapsedMean() const
+	{
+		return m_query.elapsedMean();
+	}
+
+	f32 HeatTiled::residual(Handle handle) const
+	{
+		if (m_residualProgram == gl::null) {
+			return -1.0f;
+		}
+		return m_solutionStorage.get(handle).residual.value();
+	}
+}
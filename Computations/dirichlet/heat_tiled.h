@@ -0,0 +1,109 @@
+#pragma once
+
+#include <core.h>
+#include <handle.h>
+#include <storage.h>
+#include <handle-pool.h>
+
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+#include "time_query.h"
+#include "grid_storage.h"
+#include "rhs.h"
+#include "residual.h"
+#include "dirichlet_cfg.h"
+#include "dirichlet_handle.h"
+#include "resource_provider.h"
+#include "dirichlet_dataaabb2d.h"
+#include "dirichlet_domainaabb2d.h"
+
+namespace dir2d
+{
+	// explicit forward euler of the heat equation u_t = div(grad(u)) - f(see heat.h), time steps are temporally tiled
+	// each dispatch makes _STEPS time steps of the program, solution is marching to the steady state of the data
+	class HeatTiled
+		: public HandlePool
+		, public SmartHandleProvider
+		, public IResourceProvider
+	{
+	public:
+		struct Uniforms
+		{
+			Uniforms(gl::Id program);
+
+			void setup(gl::Id program);
+			bool valid() const;
+
+			GLint curr{-1};
+			GLint hx{-1};
+			GLint hy{-1};
+			GLint dt{-1};
+		};
+
+		struct Solution
+		{
+			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, RhsType rhs, f32 courant);
+
+			gl::Id texture() const;
+			void sync() const;
+			void pingpong(); // curr ^= 1
+
+			GridStorage s[2]; // s = solution
+			GridStorage f; // f - see problem description, not allocated for analytic rhs
+			ResidualStorage residual; // allocated only if residual is tracked
+			f32 dt{}; // courant times the largest stable time step
+			int curr{};
+		};
+
+	public:
+		// residualProgram - reduce program of residual partials, residual is tracked only if program writes partials
+		// courant - fraction of the largest stable time step 1 / (2 / hx^2 + 2 / hy^2), must be in (0, 1]
+		HeatTiled(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id residualProgram = gl::null, f32 courant = 0.9f);
+
+		~HeatTiled() = default;
+
+		HeatTiled(const HeatTiled&) = delete;
+		HeatTiled& operator = (const HeatTiled&) = delete;
+
+		HeatTiled(HeatTiled&&) noexcept = delete;
+		HeatTiled& operator = (HeatTiled&&) noexcept = delete;
+
+	public:
+		Handle create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+		SmartHandle createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+
+	public: // IResourceProvider
+		bool valid(Handle handle) const override;
+		void destroy(Handle handle) override;
+
+		const DomainAabb2D& domain(Handle handle) const override;
+		gl::Id texture(Handle handle) const override;
+
+	public:
+		void update();
+
+		GLuint64 elapsed() const;
+		f64 elapsedMean() const;
+
+		// max |u_new - u_old| of the last update, negative if residual is not tracked
+		f32 residual(Handle handle) const;
+
+	private:
+		uint m_workgroupSizeX{};
+		uint m_workgroupSizeY{};
+		StorageType m_storage{};
+		f32 m_courant{};
+
+		gl::Id m_program;
+		gl::Id m_residualProgram;
+		Uniforms m_uniforms;
+		GridUniforms m_gridUniforms;
+		RhsUniforms m_rhsUniforms;
+		TimeQuery m_query;
+
+		Storage<DomainAabb2D> m_domainStorage;
+		Storage<Solution>     m_solutionStorage;
+		Storage<UpdateParams> m_configStorage;
+	};
+}
@@ -1,6 +1,7 @@
 #include "jacoby.h"
 
 #include <cassert>
+#include <vector>
 #include <exception>
 
 #include <gl-cxx/gl-header.h>
@@ -33,25 +34,45 @@ namespace dir2d
 
 
 	// solution data
-	bool Jacoby::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data)
+	bool Jacoby::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, RhsType rhs, bool coef)
 	{
 		int xVars = domain.xSplit + 1;
 		int yVars = domain.ySplit + 1;
 
 		solution.curr = 0;
 		for (int i = 0; i < 2; i++) {
-			solution.s[i] = gl::create_texture(xVars, yVars, GL_R32F);
-			glTextureSubImage2D(solution.s[i].id, 0, 0, 0, xVars, yVars, GL_RED, GL_FLOAT, data.solution.get()); // boundary conditions
+			GridStorage::create(solution.s[i], storage, xVars, yVars, data.solution.get(), 0, 1, 1, data.channels); // boundary conditions
 		}
-		solution.f = gl::create_texture(xVars, yVars, GL_R32F);
-		glTextureSubImage2D(solution.f.id, 0, 0, 0, xVars, yVars, GL_RED, GL_FLOAT, data.f.get());
+		if (rhs == RhsType::Grid) {
+			GridStorage::create(solution.f, storage, xVars, yVars, data.f.get(), 0, 1, 1, data.channels);
+		}
+
+		// k = 1 if data has no coefficient
+		if (coef) {
+			std::vector<f32> ones;
+			const f32* k = data.k.get();
+			if (!k) {
+				ones.assign(xVars * yVars * data.channels, 1.0f);
+				k = ones.data();
+			}
+			GridStorage::create(solution.k, storage, xVars, yVars, k, 0, 1, 1, data.channels);
+		}
+
+		solution.boundary = data.boundary;
+		solution.shift = data.shift;
+		solution.convection = data.convection;
 
-		return solution.s[0].valid() && solution.s[1].valid() && solution.f.valid();
+		return solution.s[0].valid() && solution.s[1].valid() && (rhs == RhsType::Analytic || solution.f.valid()) && (!coef || solution.k.valid());
 	}
 
 	gl::Id Jacoby::Solution::texture() const
 	{
-		return s[curr].id;
+		return s[curr].texture();
+	}
+
+	void Jacoby::Solution::sync() const
+	{
+		s[curr].sync();
 	}
 
 	void Jacoby::Solution::pingpong()
@@ -61,22 +82,64 @@ namespace dir2d
 
 
 	// jacoby method
-	Jacoby::Jacoby(uint workgroupSizeX, uint workgroupSizeY, gl::Id program)
+	Jacoby::Jacoby(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id residualProgram, i32 channels)
 		: m_workgroupSizeX{workgroupSizeX}
 		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
+		, m_channels{channels}
 		, m_program{program}
+		, m_residualProgram{program_has_residual(program) ? residualProgram : gl::null}
+		, m_masked{program_has_mask(program)}
+		, m_coef{program_has_coef(program)}
 		, m_uniforms(m_program)
+		, m_gridUniforms(m_program)
+		, m_rhsUniforms(m_program)
+		, m_boundaryUniforms(m_program)
+		, m_shiftUniforms(m_program)
+		, m_convectionUniforms(m_program)
 	{}
 
 	Handle Jacoby::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
 	{
+		if (data.channels != m_channels) {
+			return null_handle;
+		}
+		if (data.mask && !m_masked) {
+			return null_handle;
+		}
+		if (data.k && !m_coef) {
+			return null_handle;
+		}
+		if (!data.boundary.dirichlet() && !m_boundaryUniforms.enabled()) {
+			return null_handle;
+		}
+		if (data.shift != 0.0f && !m_shiftUniforms.enabled()) {
+			return null_handle;
+		}
+		if (!data.convection.none() && !m_convectionUniforms.enabled()) {
+			return null_handle;
+		}
+
 		Handle handle = acquire();
 
 		Solution solution;
-		if (!Solution::create(solution, domain, data)) {
+		if (!Solution::create(solution, domain, data, m_storage, m_rhsUniforms.type(), m_coef)) {
 			return null_handle;
 		}
 
+		if (m_masked) {
+			if (!MaskStorage::create(solution.mask, domain, data.mask.get(), m_workgroupSizeX, m_workgroupSizeY)) {
+				return null_handle;
+			}
+		}
+
+		if (m_residualProgram != gl::null) {
+			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			if (!ResidualStorage::create(solution.residual, numWorkgroupsX * numWorkgroupsY)) {
+				return null_handle;
+			}
+		}
+
 		m_domainStorage.emplace(handle, domain);
 		m_solutionStorage.emplace(handle, std::move(solution));
 		m_configStorage.emplace(handle, config);
@@ -120,6 +183,7 @@ namespace dir2d
 		constexpr int IMG0 = 0;
 		constexpr int IMG1 = 1;
 		constexpr int IMGF = 2;
+		constexpr int IMGK = 3;
 
 		glUseProgram(m_program);
 
@@ -129,23 +193,56 @@ namespace dir2d
 			auto& solution = m_solutionStorage.get(handle);
 			auto& config   = m_configStorage.get(handle);
 
-			glBindImageTexture(IMG0, solution.s[0].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMG1, solution.s[1].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMGF, solution.f.id, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+			solution.s[0].bind(IMG0, GL_READ_WRITE);
+			solution.s[1].bind(IMG1, GL_READ_WRITE);
+			if (m_rhsUniforms.type() == RhsType::Grid) {
+				solution.f.bind(IMGF, GL_READ_ONLY);
+			}
+			if (m_coef) {
+				solution.k.bind(IMGK, GL_READ_ONLY);
+			}
+			m_gridUniforms.set(solution.s[0]);
+			m_rhsUniforms.set(domain);
+			m_boundaryUniforms.set(solution.boundary);
+			m_shiftUniforms.set(solution.shift);
+			m_convectionUniforms.set(solution.convection);
+			if (m_residualProgram != gl::null) {
+				solution.residual.clear();
+				solution.residual.bind();
+			}
+			if (m_masked) {
+				solution.mask.bind();
+			}
 
 			glUniform1f(m_uniforms.hx, domain.hx);
 			glUniform1f(m_uniforms.hy, domain.hy);
 
+			// masked programs are dispatched over the tiles having interior points
 			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			if (m_masked) {
+				numWorkgroupsX = solution.mask.tileCount;
+				numWorkgroupsY = 1;
+			}
 			for (i32 i = 0; i < config.itersPerUpdate; i++) {
 				glUniform1i(m_uniforms.curr, solution.curr);
 				glDispatchCompute(numWorkgroupsX, numWorkgroupsY, 1);
-				glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+				glMemoryBarrier(get_storage_barrier(m_storage));
 
 				solution.pingpong();
 			}
 		}
+
+		// reduce pass of the partials accumulated by the updates
+		if (m_residualProgram != gl::null) {
+			for (auto handle : m_domainStorage) {
+				m_solutionStorage.get(handle).residual.reduce(m_residualProgram);
+			}
+		}
 		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
 	}
 
 	GLuint64 Jacoby::elapsed() const
@@ -157,4 +254,21 @@ namespace dir2d
 	{
 		return m_query.elapsedMean();
 	}
+
+	f32 Jacoby::residual(Handle handle) const
+	{
+		if (m_residualProgram == gl::null) {
+			return -1.0f;
+		}
+		return m_solutionStorage.get(handle).residual.value();
+	}
+
+	gl::Id Jacoby::rhsTexture(Handle handle) const
+	{
+		auto& f = m_solutionStorage.get(handle).f;
+		if (m_storage == StorageType::Buffer || !f.valid()) {
+			return gl::null;
+		}
+		return f.texture();
+	}
 }
\ No newline at end of file
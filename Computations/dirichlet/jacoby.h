@@ -9,6 +9,14 @@
 #include <gl-cxx/gl-types.h>
 
 #include "time_query.h"
+#include "grid_storage.h"
+#include "rhs.h"
+#include "boundary.h"
+#include "shift.h"
+#include "convection.h"
+#include "residual.h"
+#include "mask.h"
+#include "coef.h"
 #include "dirichlet_cfg.h"
 #include "dirichlet_handle.h"
 #include "resource_provider.h"
@@ -37,13 +45,20 @@ namespace dir2d
 
 		struct Solution
 		{
-			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data);
+			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, RhsType rhs, bool coef);
 
 			gl::Id texture() const;
+			void sync() const;
 			void pingpong(); // curr ^= 1
 
-			gl::Texture s[2]; // s = solution
-			gl::Texture f; // f - see problem description
+			GridStorage s[2]; // s = solution
+			GridStorage f; // f - see problem description, not allocated for analytic rhs
+			GridStorage k; // coefficient, allocated only for variable coefficient programs
+			ResidualStorage residual; // allocated only if residual is tracked
+			MaskStorage mask; // allocated only for masked programs
+			BoundaryConditions boundary; // non-dirichlet edges only for boundary programs
+			f32 shift{}; // non-zero only for shift programs
+			Convection convection; // non-zero only for convection programs
 			int curr{};
 		};
 
@@ -53,7 +68,9 @@ namespace dir2d
 		};*/
 
 	public:
-		Jacoby(uint workgroupSizeX, uint workgroupSizeY, gl::Id program);
+		// residualProgram - reduce program of residual partials, residual is tracked only if program writes partials
+		// channels - channels of the grids of the program(_GRID_CHANNELS), data of the other channel count is rejected
+		Jacoby(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id residualProgram = gl::null, i32 channels = 1);
 
 		~Jacoby() = default;
 
@@ -80,12 +97,29 @@ namespace dir2d
 		GLuint64 elapsed() const;
 		f64 elapsedMean() const;
 
+		// max |u_new - u_old| of the last update, negative if residual is not tracked
+		f32 residual(Handle handle) const;
+
+		// r32f texture of f the programs read, rewritten between updates by implicit time steps(see ImplicitHeat)
+		// null for analytic rhs and buffer storage
+		gl::Id rhsTexture(Handle handle) const;
+
 	private:
 		uint m_workgroupSizeX{};
 		uint m_workgroupSizeY{};
+		StorageType m_storage{};
+		i32 m_channels{1};
 
 		gl::Id m_program;
+		gl::Id m_residualProgram;
+		bool m_masked{};
+		bool m_coef{};
 		Uniforms m_uniforms;
+		GridUniforms m_gridUniforms;
+		RhsUniforms m_rhsUniforms;
+		BoundaryUniforms m_boundaryUniforms;
+		ShiftUniforms m_shiftUniforms;
+		ConvectionUniforms m_convectionUniforms;
 		TimeQuery m_query;
 
 		Storage<DomainAabb2D> m_domainStorage;
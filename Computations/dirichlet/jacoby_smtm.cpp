@@ -0,0 +1,235 @@
+#include "jacoby_smtm.h"
+
+#include <exception>
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include "dirichlet_util.h"
+
+namespace dir2d
+{
+	// uniforms
+	JacobySmtm::Uniforms::Uniforms(gl::Id program)
+	{
+		setup(program);
+		if (!valid()) {
+			throw std::runtime_error("Failed to get locations from jacoby-smtm program.");
+		}
+	}
+
+	void JacobySmtm::Uniforms::setup(gl::Id program)
+	{
+		curr = glGetUniformLocation(program, "curr");
+		hx   = glGetUniformLocation(program, "hx");
+		hy   = glGetUniformLocation(program, "hy");
+		numWorkgroupsX = glGetUniformLocation(program, "numWorkgroupsX");
+		numWorkgroupsY = glGetUniformLocation(program, "numWorkgroupsY");
+	}
+
+	bool JacobySmtm::Uniforms::valid() const
+	{
+		return curr != -1
+			&& hx != -1 && hy != -1
+			&& numWorkgroupsX != -1 && numWorkgroupsY != -1;
+	}
+
+
+	// solution
+	bool JacobySmtm::Solution::create(
+		Solution& solution,
+		const DomainAabb2D& domain,
+		const DataAabb2D& data,
+		StorageType storage)
+	{
+		i32 xVar = domain.xSplit + 1;
+		i32 yVar = domain.ySplit + 1;
+
+		for (int i = 0; i < 2; i++) {
+			GridStorage::create(solution.s[i], storage, xVar, yVar, data.solution.get());
+		}
+
+		GridStorage::create(solution.intermediate, storage, xVar, yVar, nullptr);
+
+		GridStorage::create(solution.f, storage, xVar, yVar, data.f.get());
+
+		solution.curr = 0;
+
+		return solution.s[0].valid()
+			&& solution.s[1].valid()
+			&& solution.intermediate.valid()
+			&& solution.f.valid();
+	}
+
+	gl::Id JacobySmtm::Solution::texture() const
+	{
+		return s[curr].texture();
+	}
+
+	void JacobySmtm::Solution::sync() const
+	{
+		s[curr].sync();
+	}
+
+	void JacobySmtm::Solution::pingpong()
+	{
+		curr ^= 1;
+	}
+
+
+	// method
+	JacobySmtm::JacobySmtm(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1, StorageType storage)
+		: m_workgroupSizeX{workgroupSizeX}
+		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
+		, m_programSt0{programSt0}
+		, m_programSt1{programSt1}
+		, m_uniformsSt0(m_programSt0)
+		, m_uniformsSt1(m_programSt1)
+		, m_gridUniformsSt0(m_programSt0)
+		, m_gridUniformsSt1(m_programSt1)
+	{
+		Uniforms dummy(m_programSt1); // dummys check, no need for second uniforms struct 'cause uniform set is the same in both stages
+	}
+
+	Handle JacobySmtm::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || !data.convection.none()) {
+			return null_handle;
+		}
+
+		Handle handle = acquire();
+
+		Solution solution;
+		if (!Solution::create(solution, domain, data, m_storage)) {
+			return null_handle;
+		}
+
+		m_domainStorage.emplace(handle, domain);
+		m_solutionStorage.emplace(handle, std::move(solution));
+		m_configStorage.emplace(handle, config);
+
+		return handle;
+	}
+
+	SmartHandle JacobySmtm::createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		Handle handle = create(domain, data, config);
+		if (handle == null_handle) {
+			return SmartHandle{};
+		}
+		return provideHandle(handle, this);
+	}
+
+	bool JacobySmtm::valid(Handle handle) const
+	{
+		return m_domainStorage.has(handle); // can check only first	
+	}
+
+	void JacobySmtm::destroy(Handle handle)
+	{
+		m_domainStorage.remove(handle);
+		m_solutionStorage.remove(handle);
+		m_configStorage.remove(handle);
+	}
+
+	const DomainAabb2D& JacobySmtm::domain(Handle handle) const
+	{
+		return m_domainStorage.get(handle);
+	}
+
+	gl::Id JacobySmtm::texture(Handle handle) const
+	{
+		return m_solutionStorage.get(handle).texture();
+	}
+
+	void JacobySmtm::update()
+	{
+		constexpr int IMG0 = 0;
+		constexpr int IMG1 = 1;
+		constexpr int IMGF = 2;
+		constexpr int IMG_INTERMEDIATE = 3;
+
+		// stage 0
+		glUseProgram(m_programSt0);
+
+		m_querySt0.start();
+		for (auto& handle : m_domainStorage) {
+			auto& domain   = m_domainStorage.get(handle);
+			auto& solution = m_solutionStorage.get(handle);
+			auto& config   = m_configStorage.get(handle);
+
+			if (config.itersPerUpdate == 0) {
+				continue;
+			}
+
+			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			auto stage0Workgroups = count_stage_workgroups(numWorkgroupsX, numWorkgroupsY, Stage::Stage0);
+
+			solution.s[0].bind(IMG0, GL_READ_WRITE);
+			solution.s[1].bind(IMG1, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			solution.intermediate.bind(IMG_INTERMEDIATE, GL_READ_WRITE);
+			m_gridUniformsSt0.set(solution.f);
+
+			glUniform1i(m_uniformsSt0.curr, solution.curr);
+			glUniform1f(m_uniformsSt0.hx, domain.hx);
+			glUniform1f(m_uniformsSt0.hy, domain.hy);
+			glUniform1i(m_uniformsSt0.numWorkgroupsX, numWorkgroupsX);
+			glUniform1i(m_uniformsSt0.numWorkgroupsY, numWorkgroupsY);
+
+			glDispatchCompute(stage0Workgroups, 1, 1);
+		}
+		glMemoryBarrier(get_storage_barrier(m_storage));
+		m_querySt0.end();
+
+		
+		// stage1 
+		glUseProgram(m_programSt1);
+
+		m_querySt1.start();
+		for (auto& handle : m_domainStorage) {
+			auto& domain   = m_domainStorage.get(handle);
+			auto& solution = m_solutionStorage.get(handle);
+			auto& config   = m_configStorage.get(handle);
+
+			if (config.itersPerUpdate == 0) {
+				continue;
+			}
+
+			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			auto stage1Workgroups = count_stage_workgroups(numWorkgroupsX, numWorkgroupsY, Stage::Stage1);
+
+			solution.s[0].bind(IMG0, GL_READ_WRITE);
+			solution.s[1].bind(IMG1, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			solution.intermediate.bind(IMG_INTERMEDIATE, GL_READ_WRITE);
+			m_gridUniformsSt1.set(solution.f);
+
+			glUniform1i(m_uniformsSt1.curr, solution.curr);
+			glUniform1f(m_uniformsSt1.hx, domain.hx);
+			glUniform1f(m_uniformsSt1.hy, domain.hy);
+			glUniform1i(m_uniformsSt1.numWorkgroupsX, numWorkgroupsX);
+			glUniform1i(m_uniformsSt1.numWorkgroupsY, numWorkgroupsY);
+
+			glDispatchCompute(stage1Workgroups, 1, 1);
+			solution.pingpong();
+		}
+		glMemoryBarrier(get_storage_barrier(m_storage));
+		m_querySt1.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
+	}
+
+	GLuint64 JacobySmtm::elapsed() const
+	{
+		return m_querySt0.elapsed() + m_querySt1.elapsed();
+	}
+
+	f64 JacobySmtm::elapsedMean() const
+	{
+		return m_querySt0.elapsedMean() + m_querySt1.elapsedMean();
+	}
+}
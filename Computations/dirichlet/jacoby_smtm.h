@@ -0,0 +1,97 @@
+#pragma once
+
+#include "jacoby.h"
+
+namespace dir2d
+{
+	class JacobySmtm
+		: HandlePool
+		, SmartHandleProvider
+		, IResourceProvider
+	{
+	public:
+		struct Uniforms
+		{
+			Uniforms(gl::Id program);
+
+			void setup(gl::Id program);
+			bool valid() const;
+
+			GLint curr{-1};
+			GLint hx{-1};
+			GLint hy{-1};
+			GLint numWorkgroupsX{-1};
+			GLint numWorkgroupsY{-1};
+		};
+
+		struct Solution
+		{
+			static bool create(
+				Solution& solution,
+				const DomainAabb2D& domain,
+				const DataAabb2D& data,
+				StorageType storage);
+
+			gl::Id texture() const;
+			void sync() const;
+			void pingpong();
+
+			GridStorage s[2];         // solution
+			GridStorage intermediate; // intermediate solution
+			GridStorage f;            // f-function from description
+
+			i32 curr{};
+		};
+
+		//struct UpdateParams
+		//{
+		//	uint itersPerUpdate{}; // if zero then no update. updated once otherwise
+		//};
+
+	public:
+		JacobySmtm(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1, StorageType storage);
+
+		~JacobySmtm() = default;
+
+		JacobySmtm(const JacobySmtm&) = delete;
+		JacobySmtm& operator = (const JacobySmtm&) = delete;
+
+		JacobySmtm(JacobySmtm&&) noexcept = delete;
+		JacobySmtm& operator = (JacobySmtm&&) noexcept = delete;
+
+	public:
+		Handle create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+		SmartHandle createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+
+	public: // IResourceProvider
+		bool valid(Handle handle) const override;
+		void destroy(Handle handle) override;
+
+		const DomainAabb2D& domain(Handle handle) const override;
+		gl::Id texture(Handle handle) const override;
+
+	public:
+		void update();
+
+		GLuint64 elapsed() const;
+		f64 elapsedMean() const;
+
+	private:
+		uint m_workgroupSizeX{};
+		uint m_workgroupSizeY{};
+		StorageType m_storage{};
+
+		gl::Id m_programSt0;
+		gl::Id m_programSt1;
+		Uniforms m_uniformsSt0;
+		Uniforms m_uniformsSt1;
+		GridUniforms m_gridUniformsSt0;
+		GridUniforms m_gridUniformsSt1;
+		TimeQuery m_querySt0;
+		TimeQuery m_querySt1;
+
+		Storage<DomainAabb2D> m_domainStorage;
+		Storage<Solution>     m_solutionStorage;
+		Storage<UpdateParams> m_configStorage;
+	};
+}
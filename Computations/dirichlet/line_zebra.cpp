@@ -0,0 +1,221 @@
+#include "line_zebra.h"
+
+#include <exception>
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include "dirichlet_util.h"
+
+namespace dir2d
+{
+	// uniforms
+	LineZebra::Uniforms::Uniforms(gl::Id program)
+	{
+		setup(program);
+		if (!valid()) {
+			throw std::runtime_error("Failed to get uniform locations from line zebra program.");
+		}
+	}
+
+	void LineZebra::Uniforms::setup(gl::Id program)
+	{
+		colour = glGetUniformLocation(program, "colour");
+		axis   = glGetUniformLocation(program, "axis");
+		w      = glGetUniformLocation(program, "w");
+		hx     = glGetUniformLocation(program, "hx");
+		hy     = glGetUniformLocation(program, "hy");
+	}
+
+	bool LineZebra::Uniforms::valid() const
+	{
+		return colour != -1 && axis != -1 && w != -1 && hx != -1 && hy != -1;
+	}
+
+
+	// solution
+	bool LineZebra::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, RhsType rhs)
+	{
+		i32 xVar = domain.xSplit + 1;
+		i32 yVar = domain.ySplit + 1;
+
+		GridStorage::create(solution.s, storage, xVar, yVar, data.solution.get());
+
+		if (rhs == RhsType::Grid) {
+			GridStorage::create(solution.f, storage, xVar, yVar, data.f.get());
+		}
+
+		// lines along the smaller step
+		solution.axis = (domain.hx <= domain.hy ? 0 : 1);
+
+		f32 hAlong   = (solution.axis == 0 ? domain.hx : domain.hy);
+		f32 hAcross  = (solution.axis == 0 ? domain.hy : domain.hx);
+		i32 along    = (solution.axis == 0 ? domain.xSplit : domain.ySplit);
+		solution.across = (solution.axis == 0 ? domain.ySplit : domain.xSplit);
+
+		solution.w = compute_optimal_line_w(hAlong, hAcross, along, solution.across);
+
+		f64 ihAlong2 = 1.0 / ((f64)hAlong * hAlong);
+		f64 ihAcross2 = 1.0 / ((f64)hAcross * hAcross);
+		solution.table = create_tridiagonal_buffer({ihAlong2, -2.0 * ihAlong2 - 2.0 * ihAcross2, ihAlong2, along - 1});
+
+		return solution.s.valid() && (rhs == RhsType::Analytic || solution.f.valid()) && solution.table.valid();
+	}
+
+	gl::Id LineZebra::Solution::texture() const
+	{
+		return s.texture();
+	}
+
+	void LineZebra::Solution::sync() const
+	{
+		s.sync();
+	}
+
+
+	// method
+	// one workgroup solves a whole line, workgroup sizes are kept for create_one_shader_sys only
+	LineZebra::LineZebra([[maybe_unused]] uint workgroupSizeX, [[maybe_unused]] uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id residualProgram)
+		: m_storage{storage}
+		, m_program{program}
+		, m_residualProgram{program_has_residual(program) ? residualProgram : gl::null}
+		, m_uniforms(m_program)
+		, m_gridUniforms(m_program)
+		, m_rhsUniforms(m_program)
+	{}
+
+	Handle LineZebra::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || data.shift != 0.0f || !data.convection.none()) {
+			return null_handle;
+		}
+
+		// line must fit into shared memory, both axes must have interior lines
+		i32 along = (domain.hx <= domain.hy ? domain.xSplit : domain.ySplit);
+		if (along - 1 > tridiagonal_max || domain.xSplit < 2 || domain.ySplit < 2) {
+			return null_handle;
+		}
+
+		Handle handle = acquire();
+
+		Solution solution;
+		if (!Solution::create(solution, domain, data, m_storage, m_rhsUniforms.type())) {
+			return null_handle;
+		}
+
+		// colour 0 has the most lines
+		if (m_residualProgram != gl::null) {
+			if (!ResidualStorage::create(solution.residual, solution.across / 2)) {
+				return null_handle;
+			}
+		}
+
+		m_domainStorage.emplace(handle, domain);
+		m_solutionStorage.emplace(handle, std::move(solution));
+		m_configStorage.emplace(handle, config);
+
+		return handle;
+	}
+
+	SmartHandle LineZebra::createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		Handle handle = create(domain, data, config);
+		if (handle == null_handle) {
+			return SmartHandle{};
+		}
+		return provideHandle(handle, this);
+	}
+
+	bool LineZebra::valid(Handle handle) const
+	{
+		return m_domainStorage.has(handle); // can check only first
+	}
+
+	void LineZebra::destroy(Handle handle)
+	{
+		m_domainStorage.remove(handle);
+		m_solutionStorage.remove(handle);
+		m_configStorage.remove(handle);
+	}
+
+	const DomainAabb2D& LineZebra::domain(Handle handle) const
+	{
+		return m_domainStorage.get(handle);
+	}
+
+	gl::Id LineZebra::texture(Handle handle) const
+	{
+		return m_solutionStorage.get(handle).texture();
+	}
+
+	void LineZebra::update()
+	{
+		constexpr int IMG = 0;
+		constexpr int IMGF = 1;
+
+		glUseProgram(m_program);
+
+		m_query.start();
+		for (auto& handle : m_domainStorage) {
+			auto& domain   = m_domainStorage.get(handle);
+			auto& solution = m_solutionStorage.get(handle);
+			auto& config   = m_configStorage.get(handle);
+
+			solution.s.bind(IMG, GL_READ_WRITE);
+			if (m_rhsUniforms.type() == RhsType::Grid) {
+				solution.f.bind(IMGF, GL_READ_ONLY);
+			}
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, tridiagonal_binding, solution.table.id);
+			m_gridUniforms.set(solution.s);
+			m_rhsUniforms.set(domain);
+			if (m_residualProgram != gl::null) {
+				solution.residual.clear();
+				solution.residual.bind();
+			}
+
+			glUniform1i(m_uniforms.axis, solution.axis);
+			glUniform1f(m_uniforms.w, solution.w);
+			glUniform1f(m_uniforms.hx, domain.hx);
+			glUniform1f(m_uniforms.hy, domain.hy);
+
+			// one workgroup per line of the colour
+			for (i32 i = 0; i < config.itersPerUpdate; i++) {
+				for (i32 colour = 0; colour < 2; colour++) {
+					glUniform1i(m_uniforms.colour, colour);
+					glDispatchCompute((solution.across - colour) / 2, 1, 1);
+					glMemoryBarrier(get_storage_barrier(m_storage));
+				}
+			}
+		}
+
+		// reduce pass of the partials accumulated by the updates
+		if (m_residualProgram != gl::null) {
+			for (auto handle : m_domainStorage) {
+				m_solutionStorage.get(handle).residual.reduce(m_residualProgram);
+			}
+		}
+		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
+	}
+
+	GLuint64 LineZebra::elapsed() const
+	{
+		return m_query.elapsed();
+	}
+
+	f64 LineZebra::elapsedMean() const
+	{
+		return m_query.elapsedMean();
+	}
+
+	f32 LineZebra::residual(Handle handle) const
+	{
+		if (m_residualProgram == gl::null) {
+			return -1.0f;
+		}
+		return m_solutionStorage.get(handle).residual.value();
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <core.h>
+#include <handle.h>
+#include <storage.h>
+#include <handle-pool.h>
+
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+#include "time_query.h"
+#include "grid_storage.h"
+#include "rhs.h"
+#include "residual.h"
+#include "tridiagonal.h"
+#include "dirichlet_cfg.h"
+#include "dirichlet_handle.h"
+#include "resource_provider.h"
+#include "dirichlet_dataaabb2d.h"
+#include "dirichlet_domainaabb2d.h"
+
+namespace dir2d
+{
+	// zebra line sor: odd lines, then even lines, every line is solved exactly by cyclic reduction on gpu(see shaders/tridiagonal.glsl)
+	// lines follow the smaller step, so the strong coupling of anisotropic grids(hx << hy) is handled by the line solves
+	// scalar problems of the whole box with constant coefficient and dirichlet edges only, line has at most tridiagonal_max unknowns
+	class LineZebra
+		: public HandlePool
+		, public SmartHandleProvider
+		, public IResourceProvider
+	{
+	public:
+		struct Uniforms
+		{
+			Uniforms(gl::Id program);
+
+			void setup(gl::Id program);
+			bool valid() const;
+
+			GLint colour{-1};
+			GLint axis{-1};
+			GLint w{-1};
+			GLint hx{-1};
+			GLint hy{-1};
+		};
+
+		struct Solution
+		{
+			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, RhsType rhs);
+
+			gl::Id texture() const;
+			void sync() const;
+
+			GridStorage s{}; // solution
+			GridStorage f{}; // f - function from description of a problem, not allocated for analytic rhs
+			ResidualStorage residual; // allocated only if residual is tracked
+			gl::Buffer table; // cyclic reduction table of the lines
+			i32 axis{}; // 0 - lines are rows, 1 - lines are columns
+			i32 across{}; // split across the lines, interior lines are 1..across - 1
+			f32 w{}; // optimal parameter of line sor
+		};
+
+	public:
+		// workgroup of the program is flattened along the lines, so its size doesn't change the dispatches
+		// residualProgram - reduce program of residual partials, residual is tracked only if program writes partials
+		LineZebra(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id residualProgram = gl::null);
+
+		~LineZebra() = default;
+
+		LineZebra(const LineZebra&) = delete;
+		LineZebra& operator = (const LineZebra&) = delete;
+
+		LineZebra(LineZebra&&) noexcept = delete;
+		LineZebra& operator = (LineZebra&&) noexcept = delete;
+
+	public:
+		Handle create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+		SmartHandle createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+
+	public: // IResourceProvider
+		bool valid(Handle handle) const override;
+		void destroy(Handle handle) override;
+
+		const DomainAabb2D& domain(Handle handle) const override;
+		gl::Id texture(Handle handle) const override;
+
+	public:
+		void update();
+
+		GLuint64 elapsed() const;
+		f64 elapsedMean() const;
+
+		// max |u_new - u_old| of the last update, negative if residual is not tracked
+		f32 residual(Handle handle) const;
+
+	private:
+		StorageType m_storage{};
+
+		gl::Id m_program;
+		gl::Id m_residualProgram;
+		Uniforms m_uniforms;
+		GridUniforms m_gridUniforms;
+		RhsUniforms m_rhsUniforms;
+		TimeQuery m_query;
+
+		Storage<DomainAabb2D> m_domainStorage;
+		Storage<Solution>     m_solutionStorage;
+		Storage<UpdateParams> m_configStorage;
+	};
+}
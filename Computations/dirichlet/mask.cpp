@@ -0,0 +1,81 @@
+#include "mask.h"
+#include "dirichlet_util.h"
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include <vector>
+#include <algorithm>
+
+namespace dir2d
+{
+	namespace
+	{
+		bool tile_has_interior(const CellType* cells, i32 width, i32 height, i32 x0, i32 y0, i32 tileWidth, i32 tileHeight)
+		{
+			i32 x1 = std::min(x0 + tileWidth, width);
+			i32 y1 = std::min(y0 + tileHeight, height);
+			for (i32 i = y0; i < y1; i++) {
+				for (i32 j = x0; j < x1; j++) {
+					if (cells[i * width + j] == CellType::Interior) {
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+	}
+
+	bool MaskStorage::create(MaskStorage& mask, const DomainAabb2D& domain, const CellType* cells, uint workgroupSizeX, uint workgroupSizeY)
+	{
+		i32 width  = domain.xSplit + 1;
+		i32 height = domain.ySplit + 1;
+
+		std::vector<CellType> defaultCells;
+		if (!cells) {
+			defaultCells.assign(width * height, CellType::Interior);
+			cells = defaultCells.data();
+		}
+
+		mask.tex = gl::create_texture(width, height, GL_R8UI);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTextureSubImage2D(mask.tex.id, 0, 0, 0, width, height, GL_RED_INTEGER, GL_UNSIGNED_BYTE, cells);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+		auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, workgroupSizeX, workgroupSizeY);
+
+		std::vector<i32> tiles; // pairs of x and y
+		for (uint y = 0; y < numWorkgroupsY; y++) {
+			for (uint x = 0; x < numWorkgroupsX; x++) {
+				if (tile_has_interior(cells, width, height, x * workgroupSizeX, y * workgroupSizeY, workgroupSizeX, workgroupSizeY)) {
+					tiles.push_back(x);
+					tiles.push_back(y);
+				}
+			}
+		}
+		mask.tileCount = tiles.size() / 2;
+
+		// buffer can't be empty
+		tiles.resize(std::max<size_t>(tiles.size(), 2), 0);
+		mask.tiles = gl::create_storage_buffer(tiles.size() * sizeof(i32), 0, tiles.data());
+
+		return mask.valid();
+	}
+
+	void MaskStorage::bind() const
+	{
+		glBindImageTexture(mask_binding, tex.id, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R8UI);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, mask_tiles_binding, tiles.id);
+	}
+
+	bool MaskStorage::valid() const
+	{
+		return tex.valid() && tiles.valid();
+	}
+
+
+	bool program_has_mask(gl::Id program)
+	{
+		return glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, "MaskTilesBlock") != GL_INVALID_INDEX;
+	}
+}
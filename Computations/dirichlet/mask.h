@@ -0,0 +1,33 @@
+#pragma once
+
+#include <core.h>
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+#include "dirichlet_dataaabb2d.h"
+#include "dirichlet_domainaabb2d.h"
+
+namespace dir2d
+{
+	// bindings of the cell mask image and of the tile list, must match MASK_BINDING and MASK_TILES_BINDING of mask.glsl
+	constexpr uint mask_binding = 5;
+	constexpr uint mask_tiles_binding = 6;
+
+	// r8ui cell types of masked domain and the list of workgroup tiles having interior points
+	// tiles are listed in the row-major order, programs built with _MASK are dispatched over the list
+	struct MaskStorage
+	{
+		// cells - nullptr if the whole box is the domain, every tile is listed then
+		static bool create(MaskStorage& mask, const DomainAabb2D& domain, const CellType* cells, uint workgroupSizeX, uint workgroupSizeY);
+
+		void bind() const;
+		bool valid() const;
+
+		gl::Texture tex;
+		gl::Buffer tiles;
+		i32 tileCount{};
+	};
+
+	// true if program reads cell mask
+	bool program_has_mask(gl::Id program);
+}
@@ -1,5 +1,6 @@
 #include "red_black.h"
 
+#include <vector>
 #include <exception>
 
 #include <gl-cxx/gl-header.h>
@@ -33,45 +34,106 @@ namespace dir2d
 
 
 	// data
-	bool RedBlack::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data)
+	bool RedBlack::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, RhsType rhs, bool coef)
 	{
 		i32 xVar = domain.xSplit + 1;
 		i32 yVar = domain.ySplit + 1;
 
-		solution.s = gl::create_texture(xVar, yVar, GL_R32F);
-		glTextureSubImage2D(solution.s.id, 0, 0, 0, xVar, yVar, GL_RED, GL_FLOAT, data.solution.get());
+		GridStorage::create(solution.s, storage, xVar, yVar, data.solution.get(), 0, 1, 1, data.channels);
 
-		solution.f = gl::create_texture(xVar, yVar, GL_R32F);
-		glTextureSubImage2D(solution.f.id, 0, 0, 0, xVar, yVar, GL_RED, GL_FLOAT, data.f.get());
+		if (rhs == RhsType::Grid) {
+			GridStorage::create(solution.f, storage, xVar, yVar, data.f.get(), 0, 1, 1, data.channels);
+		}
 
 		solution.w = compute_optimal_w(domain.hx, domain.hy, domain.xSplit, domain.ySplit);
 
-		return solution.s.valid() && solution.f.valid();
+		// k = 1 if data has no coefficient
+		if (coef) {
+			std::vector<f32> ones;
+			const f32* k = data.k.get();
+			if (!k) {
+				ones.assign(xVar * yVar * data.channels, 1.0f);
+				k = ones.data();
+			}
+			GridStorage::create(solution.k, storage, xVar, yVar, k, 0, 1, 1, data.channels);
+		}
+
+		solution.boundary = data.boundary;
+		solution.shift = data.shift;
+
+		return solution.s.valid() && (rhs == RhsType::Analytic || solution.f.valid()) && (!coef || solution.k.valid());
 	}
 
 	gl::Id RedBlack::Solution::texture() const
 	{
-		return s.id;
+		return s.texture();
+	}
+
+	void RedBlack::Solution::sync() const
+	{
+		s.sync();
 	}
 
 
 	// red-black method
-	RedBlack::RedBlack(uint workgroupSizeX, uint workgroupSizeY, gl::Id program)
+	RedBlack::RedBlack(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id residualProgram, i32 channels, i32 colours)
 		: m_workgroupSizeX{workgroupSizeX}
 		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
+		, m_channels{channels}
+		, m_colours{colours}
 		, m_program{program}
+		, m_residualProgram{program_has_residual(program) ? residualProgram : gl::null}
+		, m_masked{program_has_mask(program)}
+		, m_coef{program_has_coef(program)}
 		, m_uniforms(m_program)
+		, m_gridUniforms(m_program)
+		, m_rhsUniforms(m_program)
+		, m_boundaryUniforms(m_program)
+		, m_shiftUniforms(m_program)
 	{}
 
 	Handle RedBlack::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
 	{
+		if (data.channels != m_channels) {
+			return null_handle;
+		}
+		if (data.mask && !m_masked) {
+			return null_handle;
+		}
+		if (data.k && !m_coef) {
+			return null_handle;
+		}
+		if (!data.boundary.dirichlet() && !m_boundaryUniforms.enabled()) {
+			return null_handle;
+		}
+		if (data.shift != 0.0f && !m_shiftUniforms.enabled()) {
+			return null_handle;
+		}
+		if (!data.convection.none()) { // poisson stencil only
+			return null_handle;
+		}
+
 		Handle handle = acquire();
 
 		Solution solution;
-		if (!Solution::create(solution, domain, data)) {
+		if (!Solution::create(solution, domain, data, m_storage, m_rhsUniforms.type(), m_coef)) {
 			return gl::null;
 		}
 
+		if (m_masked) {
+			if (!MaskStorage::create(solution.mask, domain, data.mask.get(), m_workgroupSizeX, m_workgroupSizeY)) {
+				return null_handle;
+			}
+		}
+
+		if (m_residualProgram != gl::null) {
+			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			if (!ResidualStorage::create(solution.residual, numWorkgroupsX * numWorkgroupsY)) {
+				return null_handle;
+			}
+		}
+
 		m_domainStorage.emplace(handle, domain);
 		m_solutionStorage.emplace(handle, std::move(solution));
 		m_configStorage.emplace(handle, config);
@@ -107,13 +169,14 @@ namespace dir2d
 
 	gl::Id RedBlack::texture(Handle handle) const
 	{
-		return m_solutionStorage.get(handle).s.id;
+		return m_solutionStorage.get(handle).texture();
 	}
 
 	void RedBlack::update()
 	{
 		constexpr int IMG = 0;
 		constexpr int IMGF = 1;
+		constexpr int IMGK = 3;
 
 		glUseProgram(m_program);
 
@@ -123,26 +186,55 @@ namespace dir2d
 			auto& solution = m_solutionStorage.get(handle);
 			auto& config   = m_configStorage.get(handle);
 
-			glBindImageTexture(IMG, solution.s.id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMGF, solution.f.id, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+			solution.s.bind(IMG, GL_READ_WRITE);
+			if (m_rhsUniforms.type() == RhsType::Grid) {
+				solution.f.bind(IMGF, GL_READ_ONLY);
+			}
+			if (m_coef) {
+				solution.k.bind(IMGK, GL_READ_ONLY);
+			}
+			m_gridUniforms.set(solution.s);
+			m_rhsUniforms.set(domain);
+			m_boundaryUniforms.set(solution.boundary);
+			m_shiftUniforms.set(solution.shift);
+			if (m_residualProgram != gl::null) {
+				solution.residual.clear();
+				solution.residual.bind();
+			}
+			if (m_masked) {
+				solution.mask.bind();
+			}
 
 			glUniform1f(m_uniforms.w, solution.w);
 			glUniform1f(m_uniforms.hx, domain.hx);
 			glUniform1f(m_uniforms.hy, domain.hy);
 
+			// masked programs are dispatched over the tiles having interior points
 			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			if (m_masked) {
+				numWorkgroupsX = solution.mask.tileCount;
+				numWorkgroupsY = 1;
+			}
 			for (i32 i = 0; i < config.itersPerUpdate; i++) {
-				glUniform1i(m_uniforms.rb, 0);
-				glDispatchCompute(numWorkgroupsX, numWorkgroupsY, 1);
-				glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
-
-				glUniform1i(m_uniforms.rb, 1);
-				glDispatchCompute(numWorkgroupsX, numWorkgroupsY, 1);
-				glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+				for (i32 colour = 0; colour < m_colours; colour++) {
+					glUniform1i(m_uniforms.rb, colour);
+					glDispatchCompute(numWorkgroupsX, numWorkgroupsY, 1);
+					glMemoryBarrier(get_storage_barrier(m_storage));
+				}
 			}
 		}
 
+		// reduce pass of the partials accumulated by the updates
+		if (m_residualProgram != gl::null) {
+			for (auto handle : m_domainStorage) {
+				m_solutionStorage.get(handle).residual.reduce(m_residualProgram);
+			}
+		}
 		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
 	}
 
 	GLuint64 RedBlack::elapsed() const
@@ -154,4 +246,21 @@ namespace dir2d
 	{
 		return m_query.elapsedMean();
 	}
+
+	f32 RedBlack::residual(Handle handle) const
+	{
+		if (m_residualProgram == gl::null) {
+			return -1.0f;
+		}
+		return m_solutionStorage.get(handle).residual.value();
+	}
+
+	gl::Id RedBlack::rhsTexture(Handle handle) const
+	{
+		auto& f = m_solutionStorage.get(handle).f;
+		if (m_storage == StorageType::Buffer || !f.valid()) {
+			return gl::null;
+		}
+		return f.texture();
+	}
 }
\ No newline at end of file
@@ -9,6 +9,14 @@
 #include <gl-cxx/gl-types.h>
 
 #include "time_query.h"
+#include "grid_storage.h"
+#include "rhs.h"
+#include "boundary.h"
+#include "shift.h"
+#include "convection.h"
+#include "residual.h"
+#include "mask.h"
+#include "coef.h"
 #include "dirichlet_cfg.h"
 #include "dirichlet_util.h"
 #include "dirichlet_handle.h"
@@ -40,12 +48,18 @@ namespace dir2d
 
 		struct Solution
 		{
-			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data);
+			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, RhsType rhs, bool coef);
 
 			gl::Id texture() const;
-
-			gl::Texture s{}; // solution
-			gl::Texture f{}; // f - function from description of a problem
+			void sync() const;
+
+			GridStorage s{}; // solution
+			GridStorage f{}; // f - function from description of a problem, not allocated for analytic rhs
+			GridStorage k{}; // coefficient, allocated only for variable coefficient programs
+			ResidualStorage residual; // allocated only if residual is tracked
+			MaskStorage mask; // allocated only for masked programs
+			BoundaryConditions boundary; // non-dirichlet edges only for boundary programs
+			f32 shift{}; // non-zero only for shift programs
 			f32 w{}; // optimal parameter for successive overrelaxation method
 		};
 			
@@ -55,7 +69,10 @@ namespace dir2d
 		};*/
 
 	public:
-		RedBlack(uint workgroupSizeX, uint workgroupSizeY, gl::Id program);
+		// residualProgram - reduce program of residual partials, residual is tracked only if program writes partials
+		// channels - channels of the grids of the program(_GRID_CHANNELS), data of the other channel count is rejected
+		// colours - colours of the program, one dispatch per colour(9-point programs have four)
+		RedBlack(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id residualProgram = gl::null, i32 channels = 1, i32 colours = 2);
 
 		~RedBlack() = default;
 
@@ -82,12 +99,29 @@ namespace dir2d
 		GLuint64 elapsed() const;
 		f64 elapsedMean() const;
 
+		// max |u_new - u_old| of the last update, negative if residual is not tracked
+		f32 residual(Handle handle) const;
+
+		// r32f texture of f the programs read, rewritten between updates by implicit time steps(see ImplicitHeat)
+		// null for analytic rhs and buffer storage
+		gl::Id rhsTexture(Handle handle) const;
+
 	private:
 		uint m_workgroupSizeX{};
 		uint m_workgroupSizeY{};
+		StorageType m_storage{};
+		i32 m_channels{1};
+		i32 m_colours{2};
 
 		gl::Id m_program;
+		gl::Id m_residualProgram;
+		bool m_masked{};
+		bool m_coef{};
 		Uniforms m_uniforms;
+		GridUniforms m_gridUniforms;
+		RhsUniforms m_rhsUniforms;
+		BoundaryUniforms m_boundaryUniforms;
+		ShiftUniforms m_shiftUniforms;
 		TimeQuery m_query;
 
 		Storage<DomainAabb2D> m_domainStorage;
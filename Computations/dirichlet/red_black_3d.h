@@ -0,0 +1,104 @@
+#pragma once
+
+#include <core.h>
+#include <handle.h>
+#include <storage.h>
+#include <handle-pool.h>
+
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+#include "time_query.h"
+#include "grid_storage_3d.h"
+#include "residual.h"
+#include "dirichlet_cfg.h"
+#include "dirichlet_handle.h"
+#include "resource_provider.h"
+#include "dirichlet_dataaabb3d.h"
+#include "dirichlet_domainaabb3d.h"
+
+namespace dir3d
+{
+	// 7-point red-black sor, points of one colour have the same parity of x + y + z
+	// texture storage only, f is always a grid
+	class RedBlack
+		: public HandlePool
+		, public dir2d::SmartHandleProvider
+		, public dir2d::IResourceProvider
+	{
+	public:
+		struct Uniforms
+		{
+			Uniforms(gl::Id program);
+
+			void setup(gl::Id program);
+			bool valid() const;
+
+			GLint rb{-1};
+			GLint w{-1};
+			GLint hx{-1};
+			GLint hy{-1};
+			GLint hz{-1};
+		};
+
+		struct Solution
+		{
+			static bool create(Solution& solution, const DomainAabb3D& domain, const DataAabb3D& data);
+
+			gl::Id texture() const;
+			void sync() const;
+
+			VolumeStorage s; // solution
+			VolumeStorage f; // f - see problem description
+			dir2d::ResidualStorage residual; // allocated only if residual is tracked
+			f32 w{}; // optimal parameter for successive overrelaxation method
+		};
+
+	public:
+		// residualProgram - reduce program of residual partials, residual is tracked only if program writes partials
+		RedBlack(uint workgroupSizeX, uint workgroupSizeY, uint workgroupSizeZ, gl::Id program, gl::Id residualProgram = gl::null);
+
+		~RedBlack() = default;
+
+		RedBlack(const RedBlack&) = delete;
+		RedBlack& operator = (const RedBlack&) = delete;
+
+		RedBlack(RedBlack&&) noexcept = delete;
+		RedBlack& operator = (RedBlack&&) noexcept = delete;
+
+	public:
+		Handle create(const DomainAabb3D& domain, const DataAabb3D& data, const UpdateParams& config);
+		dir2d::SmartHandle createSmart(const DomainAabb3D& domain, const DataAabb3D& data, const UpdateParams& config);
+
+	public: // IResourceProvider, resources describe the displayed middle z-slice
+		bool valid(Handle handle) const override;
+		void destroy(Handle handle) override;
+
+		const dir2d::DomainAabb2D& domain(Handle handle) const override;
+		gl::Id texture(Handle handle) const override;
+
+	public:
+		void update();
+
+		GLuint64 elapsed() const;
+		f64 elapsedMean() const;
+
+		// max |u_new - u_old| of the last update, negative if residual is not tracked
+		f32 residual(Handle handle) const;
+
+	private:
+		uint m_workgroupSizeX{};
+		uint m_workgroupSizeY{};
+		uint m_workgroupSizeZ{};
+
+		gl::Id m_program;
+		gl::Id m_residualProgram;
+		Uniforms m_uniforms;
+		dir2d::TimeQuery m_query;
+
+		Storage<DomainAabb3D>        m_domainStorage;
+		Storage<dir2d::DomainAabb2D> m_sliceStorage;
+		Storage<Solution>            m_solutionStorage;
+		Storage<UpdateParams>        m_configStorage;
+	};
+}
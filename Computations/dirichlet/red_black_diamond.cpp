@@ -0,0 +1,175 @@
+#include "red_black_diamond.h"
+
+#include <exception>
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include "dirichlet_util.h"
+
+namespace dir2d
+{
+	// uniforms
+	RedBlackDiamond::Uniforms::Uniforms(gl::Id program)
+	{
+		setup(program);
+		if (!valid()) {
+			throw std::runtime_error("Failed to get uniform locations from red-black-diamond program.");
+		}
+	}
+
+	void RedBlackDiamond::Uniforms::setup(gl::Id program)
+	{
+		phaseX = glGetUniformLocation(program, "phaseX");
+		phaseY = glGetUniformLocation(program, "phaseY");
+		w  = glGetUniformLocation(program, "w");
+		hx = glGetUniformLocation(program, "hx");
+		hy = glGetUniformLocation(program, "hy");
+	}
+
+	bool RedBlackDiamond::Uniforms::valid() const
+	{
+		return phaseX != -1 && phaseY != -1 && w != -1 && hx != -1 && hy != -1;
+	}
+
+
+	// data
+	bool RedBlackDiamond::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage)
+	{
+		i32 xVar = domain.xSplit + 1;
+		i32 yVar = domain.ySplit + 1;
+
+		GridStorage::create(solution.s, storage, xVar, yVar, data.solution.get());
+
+		GridStorage::create(solution.f, storage, xVar, yVar, data.f.get());
+
+		solution.w = compute_optimal_w(domain.hx, domain.hy, domain.xSplit, domain.ySplit);
+
+		return solution.s.valid() && solution.f.valid();
+	}
+
+	gl::Id RedBlackDiamond::Solution::texture() const
+	{
+		return s.texture();
+	}
+
+	void RedBlackDiamond::Solution::sync() const
+	{
+		s.sync();
+	}
+
+
+	// red-black diamond method
+	RedBlackDiamond::RedBlackDiamond(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage)
+		: m_workgroupSizeX{workgroupSizeX}
+		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
+		, m_program{program}
+		, m_uniforms(m_program)
+		, m_gridUniforms(m_program)
+	{}
+
+	Handle RedBlackDiamond::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || !data.convection.none()) {
+			return null_handle;
+		}
+
+		Handle handle = acquire();
+
+		Solution solution;
+		if (!Solution::create(solution, domain, data, m_storage)) {
+			return gl::null;
+		}
+
+		m_domainStorage.emplace(handle, domain);
+		m_solutionStorage.emplace(handle, std::move(solution));
+		m_configStorage.emplace(handle, config);
+
+		return handle;
+	}
+
+	SmartHandle RedBlackDiamond::createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		Handle handle = create(domain, data, config);
+		if (handle == null_handle) {
+			return SmartHandle{};
+		}
+		return provideHandle(handle, this);
+	}
+
+	bool RedBlackDiamond::valid(Handle handle) const
+	{
+		return m_domainStorage.has(handle); // can check only first	
+	}
+
+	void RedBlackDiamond::destroy(Handle handle)
+	{
+		m_domainStorage.remove(handle);
+		m_solutionStorage.remove(handle);
+		m_configStorage.remove(handle);
+	}
+
+	const DomainAabb2D& RedBlackDiamond::domain(Handle handle) const
+	{
+		return m_domainStorage.get(handle);
+	}
+
+	gl::Id RedBlackDiamond::texture(Handle handle) const
+	{
+		return m_solutionStorage.get(handle).texture();
+	}
+
+	void RedBlackDiamond::update()
+	{
+		constexpr int IMG = 0;
+		constexpr int IMGF = 1;
+
+		glUseProgram(m_program);
+
+		m_query.start();
+		for (auto& handle : m_domainStorage) {
+			auto& domain   = m_domainStorage.get(handle);
+			auto& solution = m_solutionStorage.get(handle);
+			auto& config   = m_configStorage.get(handle);
+
+			solution.s.bind(IMG, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			m_gridUniforms.set(solution.f);
+
+			glUniform1f(m_uniforms.w, solution.w);
+			glUniform1f(m_uniforms.hx, domain.hx);
+			glUniform1f(m_uniforms.hy, domain.hy);
+
+			// gap tiles lie on the edges of trapezoid tiles, so there is one more of them along the axis
+			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			for (i32 i = 0; i < config.itersPerUpdate; i++) {
+				for (int phase = 0; phase < 4; phase++) {
+					int phaseX = phase & 0x1;
+					int phaseY = phase >> 1;
+
+					glUniform1i(m_uniforms.phaseX, phaseX);
+					glUniform1i(m_uniforms.phaseY, phaseY);
+					glDispatchCompute(numWorkgroupsX + phaseX, numWorkgroupsY + phaseY, 1);
+					glMemoryBarrier(get_storage_barrier(m_storage));
+				}
+			}
+		}
+
+		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
+	}
+
+	GLuint64 RedBlackDiamond::elapsed() const
+	{
+		return m_query.elapsed();
+	}
+
+	f64 RedBlackDiamond::elapsedMean() const
+	{
+		return m_query.elapsedMean();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "red_black_persistent.h"
+
+#include <algorithm>
+#include <exception>
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include "dirichlet_util.h"
+
+namespace dir2d
+{
+	namespace
+	{
+		// upper bound of the residency probe
+		constexpr uint max_probed_workgroups = 4096;
+
+		// arrived, generation, failed
+		constexpr uint sync_values = 3;
+		constexpr GLsizeiptr sync_size = sync_values * sizeof(GLuint);
+	}
+
+	// uniforms
+	RedBlackPersistent::Uniforms::Uniforms(gl::Id program)
+	{
+		setup(program);
+		if (!valid()) {
+			throw std::runtime_error("Failed to get uniform locations from persistent red-black program.");
+		}
+	}
+
+	void RedBlackPersistent::Uniforms::setup(gl::Id program)
+	{
+		probe = glGetUniformLocation(program, "probe");
+		iters = glGetUniformLocation(program, "iters");
+		w     = glGetUniformLocation(program, "w");
+		hx    = glGetUniformLocation(program, "hx");
+		hy    = glGetUniformLocation(program, "hy");
+	}
+
+	bool RedBlackPersistent::Uniforms::valid() const
+	{
+		return probe != -1 && iters != -1 && w != -1 && hx != -1 && hy != -1;
+	}
+
+
+	// data
+	bool RedBlackPersistent::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage)
+	{
+		i32 xVar = domain.xSplit + 1;
+		i32 yVar = domain.ySplit + 1;
+
+		GridStorage::create(solution.s, storage, xVar, yVar, data.solution.get());
+
+		GridStorage::create(solution.f, storage, xVar, yVar, data.f.get());
+
+		solution.w = compute_optimal_w(domain.hx, domain.hy, domain.xSplit, domain.ySplit);
+
+		return solution.s.valid() && solution.f.valid();
+	}
+
+	gl::Id RedBlackPersistent::Solution::texture() const
+	{
+		return s.texture();
+	}
+
+	void RedBlackPersistent::Solution::sync() const
+	{
+		s.sync();
+	}
+
+
+	// persistent red-black method
+	RedBlackPersistent::RedBlackPersistent(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage)
+		: m_workgroupSizeX{workgroupSizeX}
+		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
+		, m_program{program}
+		, m_uniforms(m_program)
+		, m_gridUniforms(m_program)
+	{
+		m_sync = gl::create_storage_buffer(sync_size, 0, nullptr);
+		if (!m_sync.valid()) {
+			throw std::runtime_error("Failed to create sync buffer for persistent red-black program.");
+		}
+
+		// binary search of the largest amount of co-resident workgroups
+		uint lo = 1;
+		uint hi = max_probed_workgroups;
+		if (!probe(lo)) {
+			throw std::runtime_error("Persistent red-black program failed residency probe.");
+		}
+		while (lo < hi) {
+			uint mid = lo + (hi - lo + 1) / 2;
+			if (probe(mid)) {
+				lo = mid;
+			}
+			else {
+				hi = mid - 1;
+			}
+		}
+		m_residentWorkgroups = lo;
+	}
+
+	uint RedBlackPersistent::residentWorkgroups() const
+	{
+		return m_residentWorkgroups;
+	}
+
+	bool RedBlackPersistent::probe(uint numWorkgroups)
+	{
+		constexpr int SYNC = 2;
+
+		glUseProgram(m_program);
+		glUniform1i(m_uniforms.probe, 1);
+
+		clearSync();
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SYNC, m_sync.id);
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		glDispatchCompute(numWorkgroups, 1, 1);
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+		GLuint state[sync_values]{};
+		glGetNamedBufferSubData(m_sync.id, 0, sync_size, state);
+		return state[0] == numWorkgroups && state[2] == 0;
+	}
+
+	void RedBlackPersistent::clearSync()
+	{
+		glClearNamedBufferData(m_sync.id, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+	}
+
+	void RedBlackPersistent::clearBarrier()
+	{
+		glClearNamedBufferSubData(m_sync.id, GL_R32UI, 0, 2 * sizeof(GLuint), GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+	}
+
+	bool RedBlackPersistent::barrierFailed() const
+	{
+		GLuint failed{};
+		glGetNamedBufferSubData(m_sync.id, 2 * sizeof(GLuint), sizeof(GLuint), &failed);
+		return failed != 0;
+	}
+
+	Handle RedBlackPersistent::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || !data.convection.none()) {
+			return null_handle;
+		}
+
+		Handle handle = acquire();
+
+		Solution solution;
+		if (!Solution::create(solution, domain, data, m_storage)) {
+			return gl::null;
+		}
+
+		m_domainStorage.emplace(handle, domain);
+		m_solutionStorage.emplace(handle, std::move(solution));
+		m_configStorage.emplace(handle, config);
+
+		return handle;
+	}
+
+	SmartHandle RedBlackPersistent::createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		Handle handle = create(domain, data, config);
+		if (handle == null_handle) {
+			return SmartHandle{};
+		}
+		return provideHandle(handle, this);
+	}
+
+	bool RedBlackPersistent::valid(Handle handle) const
+	{
+		return m_domainStorage.has(handle); // can check only first	
+	}
+
+	void RedBlackPersistent::destroy(Handle handle)
+	{
+		m_domainStorage.remove(handle);
+		m_solutionStorage.remove(handle);
+		m_configStorage.remove(handle);
+	}
+
+	const DomainAabb2D& RedBlackPersistent::domain(Handle handle) const
+	{
+		return m_domainStorage.get(handle);
+	}
+
+	gl::Id RedBlackPersistent::texture(Handle handle) const
+	{
+		return m_solutionStorage.get(handle).texture();
+	}
+
+	void RedBlackPersistent::update()
+	{
+		constexpr int IMG = 0;
+		constexpr int IMGF = 1;
+		constexpr int SYNC = 2;
+
+		glUseProgram(m_program);
+		glUniform1i(m_uniforms.probe, 0);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SYNC, m_sync.id);
+
+		// failures of all handles are accumulated and checked once after the update
+		clearSync();
+
+		m_query.start();
+		for (auto& handle : m_domainStorage) {
+			auto& domain   = m_domainStorage.get(handle);
+			auto& solution = m_solutionStorage.get(handle);
+			auto& config   = m_configStorage.get(handle);
+
+			solution.s.bind(IMG, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			m_gridUniforms.set(solution.f);
+
+			glUniform1f(m_uniforms.w, solution.w);
+			glUniform1f(m_uniforms.hx, domain.hx);
+			glUniform1f(m_uniforms.hy, domain.hy);
+
+			glUniform1i(m_uniforms.iters, config.itersPerUpdate);
+
+			// no more workgroups than tiles, all of them must be resident
+			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			uint numWorkgroups = std::min(numWorkgroupsX * numWorkgroupsY, m_residentWorkgroups);
+
+			clearBarrier();
+			glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+			glDispatchCompute(numWorkgroups, 1, 1);
+			glMemoryBarrier(get_storage_barrier(m_storage));
+		}
+
+		m_query.end();
+
+		// workgroups timed out in the device-wide barrier, colours were mixed and the solution is garbage
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+		if (barrierFailed()) {
+			throw std::runtime_error("Persistent red-black program timed out in device-wide barrier, workgroups were not co-resident.");
+		}
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
+	}
+
+	GLuint64 RedBlackPersistent::elapsed() const
+	{
+		return m_query.elapsed();
+	}
+
+	f64 RedBlackPersistent::elapsedMean() const
+	{
+		return m_query.elapsedMean();
+	}
+}
\ No newline at end of file
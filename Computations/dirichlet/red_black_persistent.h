@@ -0,0 +1,115 @@
+#pragma once
+
+#include <core.h>
+#include <handle.h>
+#include <storage.h>
+#include <handle-pool.h>
+
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+#include "time_query.h"
+#include "grid_storage.h"
+#include "dirichlet_cfg.h"
+#include "dirichlet_util.h"
+#include "dirichlet_handle.h"
+#include "resource_provider.h"
+#include "dirichlet_dataaabb2d.h"
+#include "dirichlet_domainaabb2d.h"
+
+namespace dir2d
+{
+	class RedBlackPersistent
+		: HandlePool
+		, SmartHandleProvider
+		, IResourceProvider
+	{
+	public:
+		struct Uniforms
+		{
+			Uniforms(gl::Id program);
+
+			void setup(gl::Id program);
+
+			bool valid() const;
+
+			GLint probe{-1};
+			GLint iters{-1};
+			GLint w{-1};
+			GLint hx{-1};
+			GLint hy{-1};
+		};
+
+		struct Solution
+		{
+			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage);
+
+			gl::Id texture() const;
+			void sync() const;
+
+			GridStorage s{}; // solution
+			GridStorage f{}; // f - function from description of a problem
+			f32 w{}; // optimal parameter for successive overrelaxation method
+		};
+			
+		/*struct UpdateParams
+		{
+			uint itersPerUpdate{};
+		};*/
+
+	public:
+		RedBlackPersistent(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage);
+
+		~RedBlackPersistent() = default;
+
+		RedBlackPersistent(const RedBlackPersistent&) = delete;
+		RedBlackPersistent& operator = (const RedBlackPersistent&) = delete;
+
+		RedBlackPersistent(RedBlackPersistent&&) noexcept = delete;
+		RedBlackPersistent& operator = (RedBlackPersistent&&) noexcept = delete;
+
+	public:
+		Handle create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+		SmartHandle createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+
+	public: // IResourceProvider
+		bool valid(Handle handle) const override;
+		void destroy(Handle handle) override;
+
+		const DomainAabb2D& domain(Handle handle) const override;
+		gl::Id texture(Handle handle) const override;
+
+	public:
+		// number of workgroups that are launched, found out by probing at construction
+		uint residentWorkgroups() const;
+
+	private:
+		bool probe(uint numWorkgroups);
+		void clearSync();
+		void clearBarrier(); // arrived and generation only, failed is kept
+		bool barrierFailed() const;
+
+	public:
+		void update();
+
+		GLuint64 elapsed() const;
+		f64 elapsedMean() const;
+
+	private:
+		uint m_workgroupSizeX{};
+		uint m_workgroupSizeY{};
+		StorageType m_storage{};
+
+		gl::Id m_program;
+		Uniforms m_uniforms;
+		GridUniforms m_gridUniforms;
+		TimeQuery m_query;
+
+		gl::Buffer m_sync; // device-wide barrier state
+		uint m_residentWorkgroups{};
+
+		Storage<DomainAabb2D> m_domainStorage;
+		Storage<Solution>     m_solutionStorage;
+		Storage<UpdateParams> m_configStorage;
+	};
+}
\ No newline at end of file
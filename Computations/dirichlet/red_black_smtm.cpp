@@ -42,34 +42,48 @@ namespace dir2d
 		const DomainAabb2D& domain,
 		const DataAabb2D& data,
 		uint workgroupSizeX,
-		uint workgroupSizeY)
+		uint workgroupSizeY,
+		StorageType storage,
+		i32 ghost,
+		RhsType rhs)
 	{
 		i32 xVar = domain.xSplit + 1;
 		i32 yVar = domain.ySplit + 1;
 
+		// ghost grids are aligned to tiles, so every access of edge tiles stays inside of the storage
+		i32 alignX = (ghost > 0 ? workgroupSizeX : 1);
+		i32 alignY = (ghost > 0 ? workgroupSizeY : 1);
+
 		for (int i = 0; i < 2; i++) {
-			solution.s[i] = gl::create_texture(xVar, yVar, GL_R32F);
-			glTextureSubImage2D(solution.s[i].id, 0, 0, 0, xVar, yVar, GL_RED, GL_FLOAT, data.solution.get());
+			GridStorage::create(solution.s[i], storage, xVar, yVar, data.solution.get(), ghost, alignX, alignY);
 		}
 
-		solution.intermediate = gl::create_texture(xVar, yVar, GL_R32F);
-		glClearTexImage(solution.intermediate.id, 0, GL_RED, GL_FLOAT, nullptr);
+		GridStorage::create(solution.intermediate, storage, xVar, yVar, nullptr, ghost, alignX, alignY);
 
-		solution.f = gl::create_texture(xVar, yVar, GL_R32F);
-		glTextureSubImage2D(solution.f.id, 0, 0, 0, xVar, yVar, GL_RED, GL_FLOAT, data.f.get());
+		if (rhs == RhsType::Grid) {
+			GridStorage::create(solution.f, storage, xVar, yVar, data.f.get(), ghost, alignX, alignY);
+		}
 
 		solution.curr = 0;
 		solution.w = compute_optimal_w(domain.hx, domain.hy, domain.xSplit, domain.ySplit);
 
+		solution.boundary = data.boundary;
+		solution.shift = data.shift;
+
 		return solution.s[0].valid()
 			&& solution.s[1].valid()
 			&& solution.intermediate.valid()
-			&& solution.f.valid();
+			&& (rhs == RhsType::Analytic || solution.f.valid());
 	}
 
 	gl::Id RedBlackTiledSmtm::Solution::texture() const
 	{
-		return s[curr].id;
+		return s[curr].texture();
+	}
+
+	void RedBlackTiledSmtm::Solution::sync() const
+	{
+		s[curr].sync();
 	}
 
 	void RedBlackTiledSmtm::Solution::pingpong()
@@ -79,23 +93,45 @@ namespace dir2d
 
 
 	// method
-	RedBlackTiledSmtm::RedBlackTiledSmtm(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1)
+	RedBlackTiledSmtm::RedBlackTiledSmtm(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1, StorageType storage, i32 ghost)
 		: m_workgroupSizeX{workgroupSizeX}
 		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
+		, m_ghost{ghost}
 		, m_programSt0{programSt0}
 		, m_programSt1{programSt1}
 		, m_uniformsSt0(m_programSt0)
 		, m_uniformsSt1(m_programSt1)
+		, m_gridUniformsSt0(m_programSt0)
+		, m_gridUniformsSt1(m_programSt1)
+		, m_rhsUniformsSt0(m_programSt0)
+		, m_rhsUniformsSt1(m_programSt1)
+		, m_boundaryUniformsSt0(m_programSt0)
+		, m_boundaryUniformsSt1(m_programSt1)
+		, m_shiftUniformsSt0(m_programSt0)
+		, m_shiftUniformsSt1(m_programSt1)
 	{
 		Uniforms dummy(m_programSt1); // dummys check, no need for second uniforms struct 'cause uniform set is the same in both stages
 	}
 
 	Handle RedBlackTiledSmtm::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
 	{
+		if (data.channels != 1 || data.mask || data.k || !data.convection.none()) {
+			return null_handle;
+		}
+
+		// both stages update the edges
+		if (!data.boundary.dirichlet() && !(m_boundaryUniformsSt0.enabled() && m_boundaryUniformsSt1.enabled())) {
+			return null_handle;
+		}
+		if (data.shift != 0.0f && !(m_shiftUniformsSt0.enabled() && m_shiftUniformsSt1.enabled())) {
+			return null_handle;
+		}
+
 		Handle handle = acquire();
 
 		Solution solution;
-		if (!Solution::create(solution, domain, data, m_workgroupSizeX, m_workgroupSizeY)) {
+		if (!Solution::create(solution, domain, data, m_workgroupSizeX, m_workgroupSizeY, m_storage, m_ghost, m_rhsUniformsSt0.type())) {
 			return null_handle;
 		}
 
@@ -160,10 +196,16 @@ namespace dir2d
 			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
 			auto stage0Workgroups = count_stage_workgroups(numWorkgroupsX, numWorkgroupsY, Stage::Stage0);
 
-			glBindImageTexture(IMG0, solution.s[0].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMG1, solution.s[1].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMGF, solution.f.id, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
-			glBindImageTexture(IMG_INTERMEDIATE, solution.intermediate.id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
+			solution.s[0].bind(IMG0, GL_READ_WRITE);
+			solution.s[1].bind(IMG1, GL_READ_WRITE);
+			if (m_rhsUniformsSt0.type() == RhsType::Grid) {
+				solution.f.bind(IMGF, GL_READ_ONLY);
+			}
+			solution.intermediate.bind(IMG_INTERMEDIATE, GL_READ_WRITE);
+			m_gridUniformsSt0.set(solution.s[0]);
+			m_rhsUniformsSt0.set(domain);
+			m_boundaryUniformsSt0.set(solution.boundary);
+			m_shiftUniformsSt0.set(solution.shift);
 
 			glUniform1i(m_uniformsSt0.curr, solution.curr);
 			glUniform1f(m_uniformsSt0.w, solution.w);
@@ -174,7 +216,7 @@ namespace dir2d
 
 			glDispatchCompute(stage0Workgroups, 1, 1);
 		}
-		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+		glMemoryBarrier(get_storage_barrier(m_storage));
 		m_querySt0.end();
 
 		
@@ -194,10 +236,16 @@ namespace dir2d
 			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
 			auto stage1Workgroups = count_stage_workgroups(numWorkgroupsX, numWorkgroupsY, Stage::Stage1);
 
-			glBindImageTexture(IMG0, solution.s[0].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMG1, solution.s[1].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMGF, solution.f.id, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
-			glBindImageTexture(IMG_INTERMEDIATE, solution.intermediate.id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
+			solution.s[0].bind(IMG0, GL_READ_WRITE);
+			solution.s[1].bind(IMG1, GL_READ_WRITE);
+			if (m_rhsUniformsSt1.type() == RhsType::Grid) {
+				solution.f.bind(IMGF, GL_READ_ONLY);
+			}
+			solution.intermediate.bind(IMG_INTERMEDIATE, GL_READ_WRITE);
+			m_gridUniformsSt1.set(solution.s[0]);
+			m_rhsUniformsSt1.set(domain);
+			m_boundaryUniformsSt1.set(solution.boundary);
+			m_shiftUniformsSt1.set(solution.shift);
 
 			glUniform1i(m_uniformsSt1.curr, solution.curr);
 			glUniform1f(m_uniformsSt1.w, solution.w);
@@ -209,8 +257,12 @@ namespace dir2d
 			glDispatchCompute(stage1Workgroups, 1, 1);
 			solution.pingpong();
 		}
-		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+		glMemoryBarrier(get_storage_barrier(m_storage));
 		m_querySt1.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
 	}
 
 	GLuint64 RedBlackTiledSmtm::elapsed() const
@@ -222,4 +274,13 @@ namespace dir2d
 	{
 		return m_querySt0.elapsedMean() + m_querySt1.elapsedMean();
 	}
+
+	gl::Id RedBlackTiledSmtm::rhsTexture(Handle handle) const
+	{
+		auto& f = m_solutionStorage.get(handle).f;
+		if (m_storage == StorageType::Buffer || !f.valid()) {
+			return gl::null;
+		}
+		return f.texture();
+	}
 }
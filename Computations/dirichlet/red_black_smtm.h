@@ -32,14 +32,20 @@ namespace dir2d
 				const DomainAabb2D& domain,
 				const DataAabb2D& data,
 				uint workgroupSizeX,
-				uint workgroupSizeY);
+				uint workgroupSizeY,
+				StorageType storage,
+				i32 ghost,
+				RhsType rhs);
 
 			gl::Id texture() const;
+			void sync() const;
 			void pingpong();
 
-			gl::Texture s[2];         // solution
-			gl::Texture intermediate; // intermediate solution
-			gl::Texture f;            // f-function from description
+			GridStorage s[2];         // solution
+			GridStorage intermediate; // intermediate solution
+			GridStorage f;            // f-function from description, not allocated for analytic rhs
+			BoundaryConditions boundary; // non-dirichlet edges only for boundary programs
+			f32 shift{}; // non-zero only for shift programs
 
 			i32 curr{};
 			f32 w{};
@@ -51,7 +57,8 @@ namespace dir2d
 		//};
 
 	public:
-		RedBlackTiledSmtm(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1);
+		// ghost - ghost layers of buffer storage, must match _STORAGE_GHOST macro of the programs
+		RedBlackTiledSmtm(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1, StorageType storage, i32 ghost = 0);
 
 		~RedBlackTiledSmtm() = default;
 
@@ -78,14 +85,28 @@ namespace dir2d
 		GLuint64 elapsed() const;
 		f64 elapsedMean() const;
 
+		// r32f texture of f the programs read, rewritten between updates by implicit time steps(see ImplicitHeat)
+		// null for analytic rhs and buffer storage
+		gl::Id rhsTexture(Handle handle) const;
+
 	private:
 		uint m_workgroupSizeX{};
 		uint m_workgroupSizeY{};
+		StorageType m_storage{};
+		i32 m_ghost{};
 
 		gl::Id m_programSt0;
 		gl::Id m_programSt1;
 		Uniforms m_uniformsSt0;
 		Uniforms m_uniformsSt1;
+		GridUniforms m_gridUniformsSt0;
+		GridUniforms m_gridUniformsSt1;
+		RhsUniforms m_rhsUniformsSt0;
+		RhsUniforms m_rhsUniformsSt1;
+		BoundaryUniforms m_boundaryUniformsSt0;
+		BoundaryUniforms m_boundaryUniformsSt1;
+		ShiftUniforms m_shiftUniformsSt0;
+		ShiftUniforms m_shiftUniformsSt1;
 		TimeQuery m_querySt0;
 		TimeQuery m_querySt1;
 
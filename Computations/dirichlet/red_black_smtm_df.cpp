@@ -0,0 +1,213 @@
+#include "red_black_smtm_df.h"
+
+#include <exception>
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include "dirichlet_util.h"
+
+namespace dir2d
+{
+	// uniforms
+	RedBlackTiledSmtmDf::Uniforms::Uniforms(gl::Id program)
+	{
+		setup(program);
+		if (!valid()) {
+			throw std::runtime_error("Failed to get locations from red-black-smtm-df program.");
+		}
+	}
+
+	void RedBlackTiledSmtmDf::Uniforms::setup(gl::Id program)
+	{
+		curr = glGetUniformLocation(program, "curr");
+		w    = glGetUniformLocation(program, "w");
+		hx   = glGetUniformLocation(program, "hx");
+		hy   = glGetUniformLocation(program, "hy");
+		numWorkgroupsX = glGetUniformLocation(program, "numWorkgroupsX");
+		numWorkgroupsY = glGetUniformLocation(program, "numWorkgroupsY");
+		stage0Workgroups = glGetUniformLocation(program, "stage0Workgroups");
+	}
+
+	bool RedBlackTiledSmtmDf::Uniforms::valid() const
+	{
+		return curr != -1 && w != -1
+			&& hx != -1 && hy != -1
+			&& numWorkgroupsX != -1 && numWorkgroupsY != -1
+			&& stage0Workgroups != -1;
+	}
+
+
+	// solution
+	bool RedBlackTiledSmtmDf::Solution::create(
+		Solution& solution,
+		const DomainAabb2D& domain,
+		const DataAabb2D& data,
+		uint workgroupSizeX,
+		uint workgroupSizeY,
+		StorageType storage)
+	{
+		i32 xVar = domain.xSplit + 1;
+		i32 yVar = domain.ySplit + 1;
+
+		for (int i = 0; i < 2; i++) {
+			GridStorage::create(solution.s[i], storage, xVar, yVar, data.solution.get());
+		}
+
+		GridStorage::create(solution.intermediate, storage, xVar, yVar, nullptr);
+
+		GridStorage::create(solution.f, storage, xVar, yVar, data.f.get());
+
+		auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, workgroupSizeX, workgroupSizeY);
+		solution.dataflow = gl::create_storage_buffer((1 + numWorkgroupsX * numWorkgroupsY) * sizeof(GLuint), 0, nullptr);
+
+		solution.curr = 0;
+		solution.w = compute_optimal_w(domain.hx, domain.hy, domain.xSplit, domain.ySplit);
+
+		return solution.s[0].valid()
+			&& solution.s[1].valid()
+			&& solution.intermediate.valid()
+			&& solution.f.valid()
+			&& solution.dataflow.valid();
+	}
+
+	gl::Id RedBlackTiledSmtmDf::Solution::texture() const
+	{
+		return s[curr].texture();
+	}
+
+	void RedBlackTiledSmtmDf::Solution::sync() const
+	{
+		s[curr].sync();
+	}
+
+	void RedBlackTiledSmtmDf::Solution::pingpong()
+	{
+		curr ^= 1;
+	}
+
+
+	// method
+	RedBlackTiledSmtmDf::RedBlackTiledSmtmDf(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage)
+		: m_workgroupSizeX{workgroupSizeX}
+		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
+		, m_program{program}
+		, m_uniforms(m_program)
+		, m_gridUniforms(m_program)
+	{}
+
+	Handle RedBlackTiledSmtmDf::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || !data.convection.none()) {
+			return null_handle;
+		}
+
+		Handle handle = acquire();
+
+		Solution solution;
+		if (!Solution::create(solution, domain, data, m_workgroupSizeX, m_workgroupSizeY, m_storage)) {
+			return null_handle;
+		}
+
+		m_domainStorage.emplace(handle, domain);
+		m_solutionStorage.emplace(handle, std::move(solution));
+		m_configStorage.emplace(handle, config);
+
+		return handle;
+	}
+
+	SmartHandle RedBlackTiledSmtmDf::createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		Handle handle = create(domain, data, config);
+		if (handle == null_handle) {
+			return SmartHandle{};
+		}
+		return provideHandle(handle, this);
+	}
+
+	bool RedBlackTiledSmtmDf::valid(Handle handle) const
+	{
+		return m_domainStorage.has(handle); // can check only first	
+	}
+
+	void RedBlackTiledSmtmDf::destroy(Handle handle)
+	{
+		m_domainStorage.remove(handle);
+		m_solutionStorage.remove(handle);
+		m_configStorage.remove(handle);
+	}
+
+	const DomainAabb2D& RedBlackTiledSmtmDf::domain(Handle handle) const
+	{
+		return m_domainStorage.get(handle);
+	}
+
+	gl::Id RedBlackTiledSmtmDf::texture(Handle handle) const
+	{
+		return m_solutionStorage.get(handle).texture();
+	}
+
+	void RedBlackTiledSmtmDf::update()
+	{
+		constexpr int IMG0 = 0;
+		constexpr int IMG1 = 1;
+		constexpr int IMGF = 2;
+		constexpr int IMG_INTERMEDIATE = 3;
+		constexpr int DATAFLOW = 4;
+
+		glUseProgram(m_program);
+
+		m_query.start();
+		for (auto& handle : m_domainStorage) {
+			auto& domain   = m_domainStorage.get(handle);
+			auto& solution = m_solutionStorage.get(handle);
+			auto& config   = m_configStorage.get(handle);
+
+			if (config.itersPerUpdate == 0) {
+				continue;
+			}
+
+			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			auto stage0Workgroups = count_stage_workgroups(numWorkgroupsX, numWorkgroupsY, Stage::Stage0);
+			auto stage1Workgroups = count_stage_workgroups(numWorkgroupsX, numWorkgroupsY, Stage::Stage1);
+
+			solution.s[0].bind(IMG0, GL_READ_WRITE);
+			solution.s[1].bind(IMG1, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			solution.intermediate.bind(IMG_INTERMEDIATE, GL_READ_WRITE);
+			m_gridUniforms.set(solution.f);
+
+			glClearNamedBufferData(solution.dataflow.id, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+			glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+			glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DATAFLOW, solution.dataflow.id);
+
+			glUniform1i(m_uniforms.curr, solution.curr);
+			glUniform1f(m_uniforms.w, solution.w);
+			glUniform1f(m_uniforms.hx, domain.hx);
+			glUniform1f(m_uniforms.hy, domain.hy);
+			glUniform1i(m_uniforms.numWorkgroupsX, numWorkgroupsX);
+			glUniform1i(m_uniforms.numWorkgroupsY, numWorkgroupsY);
+			glUniform1i(m_uniforms.stage0Workgroups, stage0Workgroups);
+
+			glDispatchCompute(stage0Workgroups + stage1Workgroups, 1, 1);
+			solution.pingpong();
+		}
+		glMemoryBarrier(get_storage_barrier(m_storage));
+		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
+	}
+
+	GLuint64 RedBlackTiledSmtmDf::elapsed() const
+	{
+		return m_query.elapsed();
+	}
+
+	f64 RedBlackTiledSmtmDf::elapsedMean() const
+	{
+		return m_query.elapsedMean();
+	}
+}
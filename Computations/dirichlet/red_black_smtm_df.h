@@ -0,0 +1,100 @@
+#pragma once
+
+#include "red_black.h"
+
+namespace dir2d
+{
+	// both smtm stages in a single dispatch: stage 1 tiles wait for their stage 0 neighbours on per-tile flags
+	class RedBlackTiledSmtmDf
+		: HandlePool
+		, SmartHandleProvider
+		, IResourceProvider
+	{
+	public:
+		struct Uniforms
+		{
+			Uniforms(gl::Id program);
+
+			void setup(gl::Id program);
+			bool valid() const;
+
+			GLint curr{-1};
+			GLint w{-1};
+			GLint hx{-1};
+			GLint hy{-1};
+			GLint numWorkgroupsX{-1};
+			GLint numWorkgroupsY{-1};
+			GLint stage0Workgroups{-1};
+		};
+
+		struct Solution
+		{
+			static bool create(
+				Solution& solution,
+				const DomainAabb2D& domain,
+				const DataAabb2D& data,
+				uint workgroupSizeX,
+				uint workgroupSizeY,
+				StorageType storage);
+
+			gl::Id texture() const;
+			void sync() const;
+			void pingpong();
+
+			GridStorage s[2];         // solution
+			GridStorage intermediate; // intermediate solution
+			GridStorage f;            // f-function from description
+			gl::Buffer dataflow;      // ticket counter + readiness flag per tile
+
+			i32 curr{};
+			f32 w{};
+		};
+
+		//struct UpdateParams
+		//{
+		//	uint itersPerUpdate{}; // if zero then no update. updated once otherwise
+		//};
+
+	public:
+		RedBlackTiledSmtmDf(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage);
+
+		~RedBlackTiledSmtmDf() = default;
+
+		RedBlackTiledSmtmDf(const RedBlackTiledSmtmDf&) = delete;
+		RedBlackTiledSmtmDf& operator = (const RedBlackTiledSmtmDf&) = delete;
+
+		RedBlackTiledSmtmDf(RedBlackTiledSmtmDf&&) noexcept = delete;
+		RedBlackTiledSmtmDf& operator = (RedBlackTiledSmtmDf&&) noexcept = delete;
+
+	public:
+		Handle create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+		SmartHandle createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config);
+
+	public: // IResourceProvider
+		bool valid(Handle handle) const override;
+		void destroy(Handle handle) override;
+
+		const DomainAabb2D& domain(Handle handle) const override;
+		gl::Id texture(Handle handle) const override;
+
+	public:
+		void update();
+
+		GLuint64 elapsed() const;
+		f64 elapsedMean() const;
+
+	private:
+		uint m_workgroupSizeX{};
+		uint m_workgroupSizeY{};
+		StorageType m_storage{};
+
+		gl::Id m_program;
+		Uniforms m_uniforms;
+		GridUniforms m_gridUniforms;
+		TimeQuery m_query;
+
+		Storage<DomainAabb2D> m_domainStorage;
+		Storage<Solution>     m_solutionStorage;
+		Storage<UpdateParams> m_configStorage;
+	};
+}
@@ -0,0 +1,183 @@
+#include "red_black_smtm_mc.h"
+
+#include <exception>
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include "dirichlet_util.h"
+
+namespace dir2d
+{
+	// uniforms
+	RedBlackSmtmMc::Uniforms::Uniforms(gl::Id program)
+	{
+		setup(program);
+		if (!valid()) {
+			throw std::runtime_error("Failed to get uniform locations from red-black-smtm-mc program.");
+		}
+	}
+
+	void RedBlackSmtmMc::Uniforms::setup(gl::Id program)
+	{
+		colour = glGetUniformLocation(program, "colour");
+		w  = glGetUniformLocation(program, "w");
+		hx = glGetUniformLocation(program, "hx");
+		hy = glGetUniformLocation(program, "hy");
+		numWorkgroupsX = glGetUniformLocation(program, "numWorkgroupsX");
+		numWorkgroupsY = glGetUniformLocation(program, "numWorkgroupsY");
+	}
+
+	bool RedBlackSmtmMc::Uniforms::valid() const
+	{
+		return colour != -1 && w != -1 && hx != -1 && hy != -1 && numWorkgroupsX != -1 && numWorkgroupsY != -1;
+	}
+
+
+	// data
+	bool RedBlackSmtmMc::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage)
+	{
+		i32 xVar = domain.xSplit + 1;
+		i32 yVar = domain.ySplit + 1;
+
+		GridStorage::create(solution.s, storage, xVar, yVar, data.solution.get());
+
+		GridStorage::create(solution.f, storage, xVar, yVar, data.f.get());
+
+		solution.w = compute_optimal_w(domain.hx, domain.hy, domain.xSplit, domain.ySplit);
+
+		return solution.s.valid() && solution.f.valid();
+	}
+
+	gl::Id RedBlackSmtmMc::Solution::texture() const
+	{
+		return s.texture();
+	}
+
+	void RedBlackSmtmMc::Solution::sync() const
+	{
+		s.sync();
+	}
+
+
+	// red-black multi-colour method
+	RedBlackSmtmMc::RedBlackSmtmMc(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, uint colours)
+		: m_workgroupSizeX{workgroupSizeX}
+		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
+		, m_colours{colours}
+		, m_program{program}
+		, m_uniforms(m_program)
+		, m_gridUniforms(m_program)
+	{
+		if (get_colour_period(m_colours) == 0) {
+			throw std::runtime_error("Red-black-smtm-mc supports only 4 or 9 colours.");
+		}
+	}
+
+	Handle RedBlackSmtmMc::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || !data.convection.none()) {
+			return null_handle;
+		}
+
+		Handle handle = acquire();
+
+		Solution solution;
+		if (!Solution::create(solution, domain, data, m_storage)) {
+			return gl::null;
+		}
+
+		m_domainStorage.emplace(handle, domain);
+		m_solutionStorage.emplace(handle, std::move(solution));
+		m_configStorage.emplace(handle, config);
+
+		return handle;
+	}
+
+	SmartHandle RedBlackSmtmMc::createSmart(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
+	{
+		Handle handle = create(domain, data, config);
+		if (handle == null_handle) {
+			return SmartHandle{};
+		}
+		return provideHandle(handle, this);
+	}
+
+	bool RedBlackSmtmMc::valid(Handle handle) const
+	{
+		return m_domainStorage.has(handle); // can check only first	
+	}
+
+	void RedBlackSmtmMc::destroy(Handle handle)
+	{
+		m_domainStorage.remove(handle);
+		m_solutionStorage.remove(handle);
+		m_configStorage.remove(handle);
+	}
+
+	const DomainAabb2D& RedBlackSmtmMc::domain(Handle handle) const
+	{
+		return m_domainStorage.get(handle);
+	}
+
+	gl::Id RedBlackSmtmMc::texture(Handle handle) const
+	{
+		return m_solutionStorage.get(handle).texture();
+	}
+
+	void RedBlackSmtmMc::update()
+	{
+		constexpr int IMG = 0;
+		constexpr int IMGF = 1;
+
+		glUseProgram(m_program);
+
+		m_query.start();
+		for (auto& handle : m_domainStorage) {
+			auto& domain   = m_domainStorage.get(handle);
+			auto& solution = m_solutionStorage.get(handle);
+			auto& config   = m_configStorage.get(handle);
+
+			solution.s.bind(IMG, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			m_gridUniforms.set(solution.f);
+
+			glUniform1f(m_uniforms.w, solution.w);
+			glUniform1f(m_uniforms.hx, domain.hx);
+			glUniform1f(m_uniforms.hy, domain.hy);
+
+			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			glUniform1i(m_uniforms.numWorkgroupsX, numWorkgroupsX);
+			glUniform1i(m_uniforms.numWorkgroupsY, numWorkgroupsY);
+
+			for (i32 i = 0; i < config.itersPerUpdate; i++) {
+				for (uint colour = 0; colour < m_colours; colour++) {
+					auto colourWorkgroups = count_colour_workgroups(numWorkgroupsX, numWorkgroupsY, m_colours, colour);
+					if (colourWorkgroups == 0) {
+						continue;
+					}
+
+					glUniform1i(m_uniforms.colour, colour);
+					glDispatchCompute(colourWorkgroups, 1, 1);
+					glMemoryBarrier(get_storage_barrier(m_storage));
+				}
+			}
+		}
+		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
+	}
+
+	GLuint64 RedBlackSmtmMc::elapsed() const
+	{
+		return m_query.elapsed();
+	}
+
+	f64 RedBlackSmtmMc::elapsedMean() const
+	{
+		return m_query.elapsedMean();
+	}
+}
\ No newline at end of file
@@ -44,20 +44,19 @@ namespace dir2d
 		const DomainAabb2D& domain,
 		const DataAabb2D& data,
 		uint workgroupSizeX,
-		uint workgroupSizeY)
+		uint workgroupSizeY,
+		StorageType storage)
 	{
 		i32 xVar = domain.xSplit + 1;
 		i32 yVar = domain.ySplit + 1;
 
 		for (int i = 0; i < 2; i++) {
-			solution.s[i] = gl::create_texture(xVar, yVar, GL_R32F);
-			glTextureSubImage2D(solution.s[i].id, 0, 0, 0, xVar, yVar, GL_RED, GL_FLOAT, data.solution.get());
+			GridStorage::create(solution.s[i], storage, xVar, yVar, data.solution.get());
 		}
 
-		solution.intermediate = gl::create_texture(xVar, yVar, GL_R32F);
+		GridStorage::create(solution.intermediate, storage, xVar, yVar, nullptr);
 
-		solution.f = gl::create_texture(xVar, yVar, GL_R32F);
-		glTextureSubImage2D(solution.f.id, 0, 0, 0, xVar, yVar, GL_RED, GL_FLOAT, data.f.get());
+		GridStorage::create(solution.f, storage, xVar, yVar, data.f.get());
 
 		solution.curr = 0;
 		solution.w = compute_optimal_w(domain.hx, domain.hy, domain.xSplit, domain.ySplit);
@@ -69,7 +68,12 @@ namespace dir2d
 
 	gl::Id RedBlackTiledSmtmS::Solution::texture() const
 	{
-		return s[curr].id;
+		return s[curr].texture();
+	}
+
+	void RedBlackTiledSmtmS::Solution::sync() const
+	{
+		s[curr].sync();
 	}
 
 	void RedBlackTiledSmtmS::Solution::pingpong()
@@ -79,19 +83,25 @@ namespace dir2d
 
 
 	// method
-	RedBlackTiledSmtmS::RedBlackTiledSmtmS(uint workgroupSizeX, uint workgroupSizeY, gl::Id program)
+	RedBlackTiledSmtmS::RedBlackTiledSmtmS(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage)
 		: m_workgroupSizeX{workgroupSizeX}
 		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
 		, m_program{program}
 		, m_uniforms(m_program)
+		, m_gridUniforms(m_program)
 	{}
 
 	Handle RedBlackTiledSmtmS::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
 	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || !data.convection.none()) {
+			return null_handle;
+		}
+
 		Handle handle = acquire();
 
 		Solution solution;
-		if (!Solution::create(solution, domain, data, m_workgroupSizeX, m_workgroupSizeY)) {
+		if (!Solution::create(solution, domain, data, m_workgroupSizeX, m_workgroupSizeY, m_storage)) {
 			return null_handle;
 		}
 
@@ -152,10 +162,11 @@ namespace dir2d
 			auto stage0Workgroups  = count_stage_workgroups(numWorkgroupsX, numWorkgroupsY, Stage::Stage0);
 			auto stage1Workgroups  = count_stage_workgroups(numWorkgroupsX, numWorkgroupsY, Stage::Stage1);
 
-			glBindImageTexture(IMG0, solution.s[0].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMG1, solution.s[1].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMGF, solution.f.id, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
-			glBindImageTexture(IMG_INTERMEDIATE, solution.intermediate.id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
+			solution.s[0].bind(IMG0, GL_READ_WRITE);
+			solution.s[1].bind(IMG1, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			solution.intermediate.bind(IMG_INTERMEDIATE, GL_READ_WRITE);
+			m_gridUniforms.set(solution.f);
 
 			glUniform1f(m_uniforms.w, solution.w);
 			glUniform1f(m_uniforms.hx, domain.hx);
@@ -168,16 +179,20 @@ namespace dir2d
 
 				glUniform1i(m_uniforms.stage, (int)Stage::Stage0);
 				glDispatchCompute(stage0Workgroups, 1, 1);
-				glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+				glMemoryBarrier(get_storage_barrier(m_storage));
 
 				glUniform1i(m_uniforms.stage, (int)Stage::Stage1);
 				glDispatchCompute(stage1Workgroups, 1, 1);
-				glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+				glMemoryBarrier(get_storage_barrier(m_storage));
 
 				solution.pingpong();
 			}
 		}
 		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
 	}
 
 	GLuint64 RedBlackTiledSmtmS::elapsed() const
@@ -33,14 +33,16 @@ namespace dir2d
 				const DomainAabb2D& domain,
 				const DataAabb2D& data,
 				uint workgroupSizeX,
-				uint workgroupSizeY);
+				uint workgroupSizeY,
+				StorageType storage);
 
 			gl::Id texture() const;
+			void sync() const;
 			void pingpong();
 
-			gl::Texture s[2];         // solution
-			gl::Texture intermediate; // intermediate solution
-			gl::Texture f;            // f-function from description
+			GridStorage s[2];         // solution
+			GridStorage intermediate; // intermediate solution
+			GridStorage f;            // f-function from description
 
 			i32 curr{};
 			f32 w{};
@@ -52,7 +54,7 @@ namespace dir2d
 		};*/
 
 	public:
-		RedBlackTiledSmtmS(uint workgroupSizeX, uint workgroupSizeY, gl::Id program);
+		RedBlackTiledSmtmS(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage);
 
 		~RedBlackTiledSmtmS() = default;
 
@@ -82,9 +84,11 @@ namespace dir2d
 	private:
 		uint m_workgroupSizeX{};
 		uint m_workgroupSizeY{};
+		StorageType m_storage{};
 
 		gl::Id m_program;
 		Uniforms m_uniforms;
+		GridUniforms m_gridUniforms;
 		TimeQuery m_query;
 
 		Storage<DomainAabb2D> m_domainStorage;
@@ -47,18 +47,17 @@ namespace dir2d
 		const DomainAabb2D& domain,
 		const DataAabb2D& data,
 		uint workgroupSizeX,
-		uint workgroupSizeY)
+		uint workgroupSizeY,
+		StorageType storage)
 	{
 		i32 xVar = domain.xSplit + 1;
 		i32 yVar = domain.ySplit + 1;
 
 		for (int i = 0; i < 2; i++) {
-			solution.s[i] = gl::create_texture(xVar, yVar, GL_R32F);
-			glTextureSubImage2D(solution.s[i].id, 0, 0, 0, xVar, yVar, GL_RED, GL_FLOAT, data.solution.get());
+			GridStorage::create(solution.s[i], storage, xVar, yVar, data.solution.get());
 		}
 
-		solution.f = gl::create_texture(xVar, yVar, GL_R32F);
-		glTextureSubImage2D(solution.f.id, 0, 0, 0, xVar, yVar, GL_RED, GL_FLOAT, data.f.get());
+		GridStorage::create(solution.f, storage, xVar, yVar, data.f.get());
 
 		solution.curr = 0;
 		solution.stage = 0;
@@ -71,7 +70,12 @@ namespace dir2d
 
 	gl::Id RedBlackTiledSmtmo::Solution::texture() const
 	{
-		return s[curr].id;
+		return s[curr].texture();
+	}
+
+	void RedBlackTiledSmtmo::Solution::sync() const
+	{
+		s[curr].sync();
 	}
 
 	void RedBlackTiledSmtmo::Solution::pingpong()
@@ -82,23 +86,30 @@ namespace dir2d
 
 
 	// method
-	RedBlackTiledSmtmo::RedBlackTiledSmtmo(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1)
+	RedBlackTiledSmtmo::RedBlackTiledSmtmo(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1, StorageType storage)
 		: m_workgroupSizeX{workgroupSizeX}
 		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
 		, m_programSt0{programSt0}
 		, m_programSt1{programSt1}
 		, m_uniformsSt0(m_programSt0)
 		, m_uniformsSt1(m_programSt1)
+		, m_gridUniformsSt0(m_programSt0)
+		, m_gridUniformsSt1(m_programSt1)
 	{
 		Uniforms dummy(m_programSt1); // dummies check, no need for second uniforms struct 'cause uniform set is the same in both stages
 	}
 
 	Handle RedBlackTiledSmtmo::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
 	{
+		if (data.channels != 1 || data.mask || data.k || !data.boundary.dirichlet() || !data.convection.none()) {
+			return null_handle;
+		}
+
 		Handle handle = acquire();
 
 		Solution solution;
-		if (!Solution::create(solution, domain, data, m_workgroupSizeX, m_workgroupSizeY)) {
+		if (!Solution::create(solution, domain, data, m_workgroupSizeX, m_workgroupSizeY, m_storage)) {
 			return null_handle;
 		}
 
@@ -162,9 +173,10 @@ namespace dir2d
 			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
 			auto stage0Workgroups = count_stage_workgroups(numWorkgroupsX, numWorkgroupsY, Stage{solution.stage});
 
-			glBindImageTexture(IMG0, solution.s[0].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMG1, solution.s[1].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMGF, solution.f.id, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+			solution.s[0].bind(IMG0, GL_READ_WRITE);
+			solution.s[1].bind(IMG1, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			m_gridUniformsSt0.set(solution.f);
 
 			glUniform1i(m_uniformsSt0.curr, solution.curr);
 			glUniform1i(m_uniformsSt0.stage, solution.stage);
@@ -176,7 +188,7 @@ namespace dir2d
 
 			glDispatchCompute(stage0Workgroups, 1, 1);
 		}
-		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+		glMemoryBarrier(get_storage_barrier(m_storage));
 		m_querySt0.end();
 
 
@@ -196,9 +208,10 @@ namespace dir2d
 			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
 			auto stage1Workgroups = count_stage_workgroups(numWorkgroupsX, numWorkgroupsY, Stage{solution.stage ^ 1});
 
-			glBindImageTexture(IMG0, solution.s[0].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMG1, solution.s[1].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMGF, solution.f.id, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+			solution.s[0].bind(IMG0, GL_READ_WRITE);
+			solution.s[1].bind(IMG1, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			m_gridUniformsSt1.set(solution.f);
 
 			glUniform1i(m_uniformsSt1.curr, solution.curr);
 			glUniform1i(m_uniformsSt1.stage, solution.stage ^ 1);
@@ -211,8 +224,12 @@ namespace dir2d
 			glDispatchCompute(stage1Workgroups, 1, 1);
 			solution.pingpong();
 		}
-		glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+		glMemoryBarrier(get_storage_barrier(m_storage));
 		m_querySt1.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
 	}
 
 	GLuint64 RedBlackTiledSmtmo::elapsed() const
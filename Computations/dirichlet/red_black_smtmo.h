@@ -33,13 +33,15 @@ namespace dir2d
 				const DomainAabb2D& domain,
 				const DataAabb2D& data,
 				uint workgroupSizeX,
-				uint workgroupSizeY);
+				uint workgroupSizeY,
+				StorageType storage);
 
 			gl::Id texture() const;
+			void sync() const;
 			void pingpong();
 
-			gl::Texture s[2]; // solution
-			gl::Texture f;    // f-function from description
+			GridStorage s[2]; // solution
+			GridStorage f;    // f-function from description
 
 			i32 curr{};
 			i32 stage{};
@@ -52,7 +54,7 @@ namespace dir2d
 		//};
 
 	public:
-		RedBlackTiledSmtmo(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1);
+		RedBlackTiledSmtmo(uint workgroupSizeX, uint workgroupSizeY, gl::Id programSt0, gl::Id programSt1, StorageType storage);
 
 		~RedBlackTiledSmtmo() = default;
 
@@ -82,11 +84,14 @@ namespace dir2d
 	private:
 		uint m_workgroupSizeX{};
 		uint m_workgroupSizeY{};
+		StorageType m_storage{};
 
 		gl::Id m_programSt0;
 		gl::Id m_programSt1;
 		Uniforms m_uniformsSt0;
 		Uniforms m_uniformsSt1;
+		GridUniforms m_gridUniformsSt0;
+		GridUniforms m_gridUniformsSt1;
 		TimeQuery m_querySt0;
 		TimeQuery m_querySt1;
 
@@ -33,27 +33,37 @@ namespace dir2d
 
 
 	// solution
-	bool RedBlackTiled::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data)
+	bool RedBlackTiled::Solution::create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, RhsType rhs)
 	{
 		i32 xVar = domain.xSplit + 1;
 		i32 yVar = domain.ySplit + 1;
 
 		for (int i = 0; i < 2; i++) {
-			solution.s[i] = gl::create_texture(xVar, yVar, GL_R32F);
-			glTextureSubImage2D(solution.s[i].id, 0, 0, 0, xVar, yVar, GL_RED, GL_FLOAT, data.solution.get());
+			GridStorage::create(solution.s[i], storage, xVar, yVar, data.solution.get());
+		}
+		if (rhs == RhsType::Grid) {
+			GridStorage::create(solution.f, storage, xVar, yVar, data.f.get());
 		}
-		solution.f = gl::create_texture(xVar, yVar, GL_R32F);
-		glTextureSubImage2D(solution.f.id, 0, 0, 0, xVar, yVar, GL_RED, GL_FLOAT, data.f.get());
 
 		solution.curr = 0;
-		solution.w = compute_optimal_w(domain.hx, domain.hy, domain.xSplit, domain.ySplit);
+		// optimal w of the poisson problem makes SOR diverge on convective problems, they are solved by gauss-seidel
+		solution.w = (data.convection.none() ? compute_optimal_w(domain.hx, domain.hy, domain.xSplit, domain.ySplit) : 1.0f);
+
+		solution.boundary = data.boundary;
+		solution.shift = data.shift;
+		solution.convection = data.convection;
 
-		return solution.s[0].valid() && solution.s[1].valid() && solution.f.valid();
+		return solution.s[0].valid() && solution.s[1].valid() && (rhs == RhsType::Analytic || solution.f.valid());
 	}
 
 	gl::Id RedBlackTiled::Solution::texture() const
 	{
-		return s[curr].id;
+		return s[curr].texture();
+	}
+
+	void RedBlackTiled::Solution::sync() const
+	{
+		s[curr].sync();
 	}
 
 	void RedBlackTiled::Solution::pingpong()
@@ -63,22 +73,49 @@ namespace dir2d
 
 
 	// method
-	RedBlackTiled::RedBlackTiled(uint workgroupSizeX, uint workgroupSizeY, gl::Id program)
+	RedBlackTiled::RedBlackTiled(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id residualProgram)
 		: m_workgroupSizeX{workgroupSizeX}
 		, m_workgroupSizeY{workgroupSizeY}
+		, m_storage{storage}
 		, m_program{program}
+		, m_residualProgram{program_has_residual(program) ? residualProgram : gl::null}
 		, m_uniforms(m_program)
+		, m_gridUniforms(m_program)
+		, m_rhsUniforms(m_program)
+		, m_boundaryUniforms(m_program)
+		, m_shiftUniforms(m_program)
+		, m_convectionUniforms(m_program)
 	{}
 
 	Handle RedBlackTiled::create(const DomainAabb2D& domain, const DataAabb2D& data, const UpdateParams& config)
 	{
+		if (data.channels != 1 || data.mask || data.k) {
+			return null_handle;
+		}
+		if (!data.boundary.dirichlet() && !m_boundaryUniforms.enabled()) {
+			return null_handle;
+		}
+		if (data.shift != 0.0f && !m_shiftUniforms.enabled()) {
+			return null_handle;
+		}
+		if (!data.convection.none() && !m_convectionUniforms.enabled()) {
+			return null_handle;
+		}
+
 		Handle handle = acquire();
 
 		Solution solution;
-		if (!Solution::create(solution, domain, data)) {
+		if (!Solution::create(solution, domain, data, m_storage, m_rhsUniforms.type())) {
 			return null_handle;
 		}
 
+		if (m_residualProgram != gl::null) {
+			auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(domain.xSplit, domain.ySplit, m_workgroupSizeX, m_workgroupSizeY);
+			if (!ResidualStorage::create(solution.residual, numWorkgroupsX * numWorkgroupsY)) {
+				return null_handle;
+			}
+		}
+
 		m_domainStorage.emplace(handle, domain);
 		m_solutionStorage.emplace(handle, std::move(solution));
 		m_configStorage.emplace(handle, config);
@@ -131,9 +168,20 @@ namespace dir2d
 			auto& solution = m_solutionStorage.get(handle);
 			auto& config   = m_configStorage.get(handle);
 
-			glBindImageTexture(IMG0, solution.s[0].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMG1, solution.s[1].id, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32F);
-			glBindImageTexture(IMGF, solution.f.id, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+			solution.s[0].bind(IMG0, GL_READ_WRITE);
+			solution.s[1].bind(IMG1, GL_READ_WRITE);
+			if (m_rhsUniforms.type() == RhsType::Grid) {
+				solution.f.bind(IMGF, GL_READ_ONLY);
+			}
+			m_gridUniforms.set(solution.s[0]);
+			m_rhsUniforms.set(domain);
+			m_boundaryUniforms.set(solution.boundary);
+			m_shiftUniforms.set(solution.shift);
+			m_convectionUniforms.set(solution.convection);
+			if (m_residualProgram != gl::null) {
+				solution.residual.clear();
+				solution.residual.bind();
+			}
 
 			glUniform1f(m_uniforms.w, solution.w);
 			glUniform1f(m_uniforms.hx, domain.hx);
@@ -143,11 +191,22 @@ namespace dir2d
 			for (uint i = 0; i < config.itersPerUpdate; i++) {
 				glUniform1i(m_uniforms.curr, solution.curr);
 				glDispatchCompute(numWorkgroupsX, numWorkgroupsY, 1);
-				glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+				glMemoryBarrier(get_storage_barrier(m_storage));
 				solution.pingpong();
 			}
 		}
+
+		// reduce pass of the partials accumulated by the updates
+		if (m_residualProgram != gl::null) {
+			for (auto handle : m_domainStorage) {
+				m_solutionStorage.get(handle).residual.reduce(m_residualProgram);
+			}
+		}
 		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
 	}
 
 	GLuint64 RedBlackTiled::elapsed() const
@@ -159,4 +218,21 @@ namespace dir2d
 	{
 		return m_query.elapsedMean();
 	}
+
+	f32 RedBlackTiled::residual(Handle handle) const
+	{
+		if (m_residualProgram == gl::null) {
+			return -1.0f;
+		}
+		return m_solutionStorage.get(handle).residual.value();
+	}
+
+	gl::Id RedBlackTiled::rhsTexture(Handle handle) const
+	{
+		auto& f = m_solutionStorage.get(handle).f;
+		if (m_storage == StorageType::Buffer || !f.valid()) {
+			return gl::null;
+		}
+		return f.texture();
+	}
 }
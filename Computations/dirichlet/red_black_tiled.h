@@ -25,13 +25,18 @@ namespace dir2d
 
 		struct Solution
 		{
-			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data);
+			static bool create(Solution& solution, const DomainAabb2D& domain, const DataAabb2D& data, StorageType storage, RhsType rhs);
 
 			gl::Id texture() const;
+			void sync() const;
 			void pingpong();
 
-			gl::Texture s[2]; // solution
-			gl::Texture f{}; // f-function from problem description
+			GridStorage s[2]; // solution
+			GridStorage f{}; // f-function from problem description, not allocated for analytic rhs
+			ResidualStorage residual; // allocated only if residual is tracked
+			BoundaryConditions boundary; // non-dirichlet edges only for boundary programs
+			f32 shift{}; // non-zero only for shift programs
+			Convection convection; // non-zero only for convection programs
 
 			i32 curr{};
 			f32 w{};
@@ -43,7 +48,8 @@ namespace dir2d
 		};*/
 
 	public:
-		RedBlackTiled(uint workgroupSizeX, uint workgroupSizeY, gl::Id program);
+		// residualProgram - reduce program of residual partials, residual is tracked only if program writes partials
+		RedBlackTiled(uint workgroupSizeX, uint workgroupSizeY, gl::Id program, StorageType storage, gl::Id residualProgram = gl::null);
 
 		~RedBlackTiled() = default;
 
@@ -70,12 +76,26 @@ namespace dir2d
 		GLuint64 elapsed() const;
 		f64 elapsedMean() const;
 
+		// max |u_new - u_old| of the last update, negative if residual is not tracked
+		f32 residual(Handle handle) const;
+
+		// r32f texture of f the programs read, rewritten between updates by implicit time steps(see ImplicitHeat)
+		// null for analytic rhs and buffer storage
+		gl::Id rhsTexture(Handle handle) const;
+
 	private:
 		uint m_workgroupSizeX{};
 		uint m_workgroupSizeY{};
+		StorageType m_storage{};
 
 		gl::Id m_program;
+		gl::Id m_residualProgram;
 		Uniforms m_uniforms;
+		GridUniforms m_gridUniforms;
+		RhsUniforms m_rhsUniforms;
+		BoundaryUniforms m_boundaryUniforms;
+		ShiftUniforms m_shiftUniforms;
+		ConvectionUniforms m_convectionUniforms;
 		TimeQuery m_query;
 
 		Storage<DomainAabb2D> m_domainStorage;
@@ -0,0 +1,203 @@
+#include "red_black_tiled_3d.h"
+
+#include <exception>
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include "dirichlet_util.h"
+
+namespace dir3d
+{
+	// uniforms
+	RedBlackTiled::Uniforms::Uniforms(gl::Id program)
+	{
+		setup(program);
+		if (!valid()) {
+			throw std::runtime_error("Failed to get uniform locations from 3d red-black-tiled program.");
+		}
+	}
+
+	void RedBlackTiled::Uniforms::setup(gl::Id program)
+	{
+		curr = glGetUniformLocation(program, "curr");
+		w    = glGetUniformLocation(program, "w");
+		hx   = glGetUniformLocation(program, "hx");
+		hy   = glGetUniformLocation(program, "hy");
+		hz   = glGetUniformLocation(program, "hz");
+	}
+
+	bool RedBlackTiled::Uniforms::valid() const
+	{
+		return curr != -1 && w != -1 && hx != -1 && hy != -1 && hz != -1;
+	}
+
+
+	// solution
+	bool RedBlackTiled::Solution::create(Solution& solution, const DomainAabb3D& domain, const DataAabb3D& data)
+	{
+		i32 xVar = domain.xSplit + 1;
+		i32 yVar = domain.ySplit + 1;
+		i32 zVar = domain.zSplit + 1;
+
+		solution.curr = 0;
+		for (int i = 0; i < 2; i++) {
+			VolumeStorage::create(solution.s[i], xVar, yVar, zVar, data.solution.get(), true);
+		}
+		VolumeStorage::create(solution.f, xVar, yVar, zVar, data.f.get());
+
+		solution.w = compute_optimal_w(domain.hx, domain.hy, domain.hz, domain.xSplit, domain.ySplit, domain.zSplit);
+
+		return solution.s[0].valid() && solution.s[1].valid() && solution.f.valid();
+	}
+
+	gl::Id RedBlackTiled::Solution::texture() const
+	{
+		return s[curr].texture();
+	}
+
+	void RedBlackTiled::Solution::sync() const
+	{
+		s[curr].sync();
+	}
+
+	void RedBlackTiled::Solution::pingpong()
+	{
+		curr ^= 1;
+	}
+
+
+	// method
+	RedBlackTiled::RedBlackTiled(uint workgroupSizeX, uint workgroupSizeY, uint workgroupSizeZ, gl::Id program, gl::Id residualProgram)
+		: m_workgroupSizeX{workgroupSizeX}
+		, m_workgroupSizeY{workgroupSizeY}
+		, m_workgroupSizeZ{workgroupSizeZ}
+		, m_program{program}
+		, m_residualProgram{dir2d::program_has_residual(program) ? residualProgram : gl::null}
+		, m_uniforms(m_program)
+	{}
+
+	Handle RedBlackTiled::create(const DomainAabb3D& domain, const DataAabb3D& data, const UpdateParams& config)
+	{
+		Handle handle = acquire();
+
+		Solution solution;
+		if (!Solution::create(solution, domain, data)) {
+			return null_handle;
+		}
+
+		if (m_residualProgram != gl::null) {
+			auto [numWorkgroupsX, numWorkgroupsY, numWorkgroupsZ] = get_num_workgroups(domain.xSplit, domain.ySplit, domain.zSplit, m_workgroupSizeX, m_workgroupSizeY, m_workgroupSizeZ);
+			if (!dir2d::ResidualStorage::create(solution.residual, numWorkgroupsX * numWorkgroupsY * numWorkgroupsZ)) {
+				return null_handle;
+			}
+		}
+
+		m_domainStorage.emplace(handle, domain);
+		m_sliceStorage.emplace(handle, DomainAabb3D::slice_domain(domain));
+		m_solutionStorage.emplace(handle, std::move(solution));
+		m_configStorage.emplace(handle, config);
+
+		return handle;
+	}
+
+	dir2d::SmartHandle RedBlackTiled::createSmart(const DomainAabb3D& domain, const DataAabb3D& data, const UpdateParams& config)
+	{
+		Handle handle = create(domain, data, config);
+		if (handle == null_handle) {
+			return dir2d::SmartHandle{};
+		}
+		return provideHandle(handle, this);
+	}
+
+	bool RedBlackTiled::valid(Handle handle) const
+	{
+		return m_domainStorage.has(handle); // can check only first
+	}
+
+	void RedBlackTiled::destroy(Handle handle)
+	{
+		m_domainStorage.remove(handle);
+		m_sliceStorage.remove(handle);
+		m_solutionStorage.remove(handle);
+		m_configStorage.remove(handle);
+	}
+
+	const dir2d::DomainAabb2D& RedBlackTiled::domain(Handle handle) const
+	{
+		return m_sliceStorage.get(handle);
+	}
+
+	gl::Id RedBlackTiled::texture(Handle handle) const
+	{
+		return m_solutionStorage.get(handle).texture();
+	}
+
+	void RedBlackTiled::update()
+	{
+		constexpr int IMG0 = 0;
+		constexpr int IMG1 = 1;
+		constexpr int IMGF = 2;
+
+		glUseProgram(m_program);
+
+		m_query.start();
+		for (auto handle : m_domainStorage) {
+			auto& domain   = m_domainStorage.get(handle);
+			auto& solution = m_solutionStorage.get(handle);
+			auto& config   = m_configStorage.get(handle);
+
+			solution.s[0].bind(IMG0, GL_READ_WRITE);
+			solution.s[1].bind(IMG1, GL_READ_WRITE);
+			solution.f.bind(IMGF, GL_READ_ONLY);
+			if (m_residualProgram != gl::null) {
+				solution.residual.clear();
+				solution.residual.bind();
+			}
+
+			glUniform1f(m_uniforms.w, solution.w);
+			glUniform1f(m_uniforms.hx, domain.hx);
+			glUniform1f(m_uniforms.hy, domain.hy);
+			glUniform1f(m_uniforms.hz, domain.hz);
+
+			auto [numWorkgroupsX, numWorkgroupsY, numWorkgroupsZ] = get_num_workgroups(domain.xSplit, domain.ySplit, domain.zSplit, m_workgroupSizeX, m_workgroupSizeY, m_workgroupSizeZ);
+			for (uint i = 0; i < config.itersPerUpdate; i++) {
+				glUniform1i(m_uniforms.curr, solution.curr);
+				glDispatchCompute(numWorkgroupsX, numWorkgroupsY, numWorkgroupsZ);
+				glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+				solution.pingpong();
+			}
+		}
+
+		// reduce pass of the partials accumulated by the updates
+		if (m_residualProgram != gl::null) {
+			for (auto handle : m_domainStorage) {
+				m_solutionStorage.get(handle).residual.reduce(m_residualProgram);
+			}
+		}
+		m_query.end();
+
+		for (auto handle : m_domainStorage) {
+			m_solutionStorage.get(handle).sync();
+		}
+	}
+
+	GLuint64 RedBlackTiled::elapsed() const
+	{
+		return m_query.elapsed();
+	}
+
+	f64 RedBlackTiled::elapsedMean() const
+	{
+		return m_query.elapsedMean();
+	}
+
+	f32 RedBlackTiled::residual(Handle handle) const
+	{
+		if (m_residualProgram == gl::null) {
+			return -1.0f;
+		}
+		return m_solutionStorage.get(handle).residual.value();
+	}
+}
@@ -0,0 +1,54 @@
+#include "residual.h"
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+namespace dir2d
+{
+	bool ResidualStorage::create(ResidualStorage& residual, i32 partials)
+	{
+		residual.partials = partials;
+		residual.buffer = gl::create_storage_buffer((partials + 1) * sizeof(f32), GL_DYNAMIC_STORAGE_BIT);
+		residual.clear();
+		return residual.valid();
+	}
+
+	void ResidualStorage::bind() const
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, residual_binding, buffer.id);
+	}
+
+	void ResidualStorage::clear()
+	{
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+		glClearNamedBufferData(buffer.id, GL_R32F, GL_RED, GL_FLOAT, nullptr);
+	}
+
+	void ResidualStorage::reduce(gl::Id program) const
+	{
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		glUseProgram(program);
+		glUniform1i(glGetUniformLocation(program, "count"), partials);
+		bind();
+		glDispatchCompute(1, 1, 1);
+	}
+
+	f32 ResidualStorage::value() const
+	{
+		f32 result{};
+		glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+		glGetNamedBufferSubData(buffer.id, partials * sizeof(f32), sizeof(f32), &result);
+		return result;
+	}
+
+	bool ResidualStorage::valid() const
+	{
+		return buffer.valid();
+	}
+
+
+	bool program_has_residual(gl::Id program)
+	{
+		return glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, "ResidualBlock") != GL_INVALID_INDEX;
+	}
+}
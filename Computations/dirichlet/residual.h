@@ -0,0 +1,33 @@
+#pragma once
+
+#include <core.h>
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+namespace dir2d
+{
+	// binding of the partials buffer, must match RESIDUAL_BINDING of residual.glsl
+	constexpr uint residual_binding = 7;
+
+	// per-workgroup partials of max |u_new - u_old| written by programs built with _RESIDUAL
+	// partials are followed by a slot for the value reduced by residual_reduce program
+	struct ResidualStorage
+	{
+		static bool create(ResidualStorage& residual, i32 partials);
+
+		void bind() const;
+		void clear();
+		void reduce(gl::Id program) const; // result stays on gpu, changes current program
+
+		// reads reduced value back, waits for the gpu
+		f32 value() const;
+
+		bool valid() const;
+
+		gl::Buffer buffer;
+		i32 partials{};
+	};
+
+	// true if program writes residual partials
+	bool program_has_residual(gl::Id program);
+}
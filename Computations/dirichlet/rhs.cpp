@@ -0,0 +1,32 @@
+#include "rhs.h"
+
+#include <gl-cxx/gl-header.h>
+
+namespace dir2d
+{
+	RhsUniforms::RhsUniforms(gl::Id program)
+	{
+		setup(program);
+	}
+
+	void RhsUniforms::setup(gl::Id program)
+	{
+		origin = glGetUniformLocation(program, "rhsOrigin");
+		step   = glGetUniformLocation(program, "rhsStep");
+	}
+
+	void RhsUniforms::set(const DomainAabb2D& domain) const
+	{
+		if (origin != -1) {
+			glUniform2f(origin, domain.x0, domain.y0);
+		}
+		if (step != -1) {
+			glUniform2f(step, domain.hx, domain.hy);
+		}
+	}
+
+	RhsType RhsUniforms::type() const
+	{
+		return (origin != -1 ? RhsType::Analytic : RhsType::Grid);
+	}
+}
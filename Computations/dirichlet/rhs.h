@@ -0,0 +1,32 @@
+#pragma once
+
+#include <core.h>
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+#include "dirichlet_domainaabb2d.h"
+
+namespace dir2d
+{
+	// where f lives, follows _RHS_EXPR macro of the programs
+	enum class RhsType
+	{
+		Grid,     // f grid uploaded from DataAabb2D
+		Analytic, // f is evaluated by programs, no grid is allocated
+	};
+
+	// uniforms required only by analytic rhs, locations are -1 otherwise
+	struct RhsUniforms
+	{
+		RhsUniforms() = default;
+		RhsUniforms(gl::Id program);
+
+		void setup(gl::Id program);
+		void set(const DomainAabb2D& domain) const;
+
+		RhsType type() const;
+
+		GLint origin{-1};
+		GLint step{-1};
+	};
+}
@@ -0,0 +1,28 @@
+#include "shift.h"
+
+#include <gl-cxx/gl-header.h>
+
+namespace dir2d
+{
+	ShiftUniforms::ShiftUniforms(gl::Id program)
+	{
+		setup(program);
+	}
+
+	void ShiftUniforms::setup(gl::Id program)
+	{
+		shift = glGetUniformLocation(program, "shift");
+	}
+
+	void ShiftUniforms::set(f32 value) const
+	{
+		if (shift != -1) {
+			glUniform1f(shift, value);
+		}
+	}
+
+	bool ShiftUniforms::enabled() const
+	{
+		return shift != -1;
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <core.h>
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+namespace dir2d
+{
+	// uniform of programs solving shifted problems div(grad(u)) - shift * u = f(_SHIFT), location is -1 otherwise
+	struct ShiftUniforms
+	{
+		ShiftUniforms() = default;
+		ShiftUniforms(gl::Id program);
+
+		void setup(gl::Id program);
+		void set(f32 value) const;
+
+		// false if program solves poisson problems only, shifted problems are rejected then
+		bool enabled() const;
+
+		GLint shift{-1};
+	};
+}
@@ -0,0 +1,138 @@
+#include "tridiagonal.h"
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+
+namespace dir2d
+{
+	namespace
+	{
+		// max relative difference of cyclic reduction and thomas algorithm on the line with d = 1
+		f64 cyclic_reduction_error(const TridiagonalLine& line, const std::vector<f32>& table)
+		{
+			std::vector<f32> expected(line.n, 1.0f);
+			std::vector<f32> actual(line.n, 1.0f);
+			thomas_solve(line, expected.data());
+			cyclic_reduction_solve(line, table, actual.data());
+
+			f64 error{};
+			f64 norm{};
+			for (i32 i = 0; i < line.n; i++) {
+				error = std::max(error, (f64)std::abs(actual[i] - expected[i]));
+				norm = std::max(norm, (f64)std::abs(expected[i]));
+			}
+			return norm != 0.0 ? error / norm : error;
+		}
+	}
+
+	void thomas_solve(const TridiagonalLine& line, f32* d)
+	{
+		i32 n = line.n;
+		if (n <= 0) {
+			return;
+		}
+
+		// forward sweep keeps modified c, d is replaced with modified d
+		std::vector<f64> c(n);
+		std::vector<f64> x(n);
+		c[0] = line.c / line.b;
+		x[0] = d[0] / line.b;
+		for (i32 i = 1; i < n; i++) {
+			f64 m = line.b - line.a * c[i - 1];
+			c[i] = line.c / m;
+			x[i] = (d[i] - line.a * x[i - 1]) / m;
+		}
+
+		for (i32 i = n - 2; i >= 0; i--) {
+			x[i] -= c[i] * x[i + 1];
+		}
+		std::copy(x.begin(), x.end(), d);
+	}
+
+	std::vector<f32> create_cyclic_reduction_table(const TridiagonalLine& line)
+	{
+		i32 n = line.n;
+		if (n <= 0) {
+			return {};
+		}
+
+		// equations 1..n, the first has no lower and the last has no upper neighbour
+		std::vector<f64> a(n + 1, line.a);
+		std::vector<f64> b(n + 1, line.b);
+		std::vector<f64> c(n + 1, line.c);
+		a[1] = 0.0;
+		c[n] = 0.0;
+
+		std::vector<f32> multipliers;
+		for (i32 d = 1; 2 * d <= n; d *= 2) {
+			for (i32 i = 2 * d; i <= n; i += 2 * d) {
+				bool upper = i + d <= n;
+
+				f64 k1 = a[i] / b[i - d];
+				f64 k2 = upper ? c[i] / b[i + d] : 0.0;
+				b[i] -= k1 * c[i - d] + (upper ? k2 * a[i + d] : 0.0);
+				a[i] = -k1 * a[i - d];
+				c[i] = upper ? -k2 * c[i + d] : 0.0;
+
+				multipliers.push_back((f32)k1);
+				multipliers.push_back((f32)k2);
+			}
+		}
+
+		std::vector<f32> table;
+		table.reserve(3 * n + multipliers.size());
+		for (i32 i = 1; i <= n; i++) {
+			table.push_back((f32)a[i]);
+			table.push_back((f32)c[i]);
+			table.push_back((f32)(1.0 / b[i]));
+		}
+		table.insert(table.end(), multipliers.begin(), multipliers.end());
+		return table;
+	}
+
+	void cyclic_reduction_solve(const TridiagonalLine& line, const std::vector<f32>& table, f32* d)
+	{
+		i32 n = line.n;
+		if (n <= 0) {
+			return;
+		}
+
+		// unknowns at 1..n, zero at 0 and past the end
+		std::vector<f32> x(2 * n + 2, 0.0f);
+		std::copy(d, d + n, x.begin() + 1);
+
+		i32 offset = 3 * n;
+		for (i32 step = 1; 2 * step <= n; step *= 2) {
+			i32 count = n / (2 * step);
+			for (i32 m = 0; m < count; m++) {
+				i32 i = 2 * step * (m + 1);
+				x[i] -= table[offset + 2 * m] * x[i - step] + table[offset + 2 * m + 1] * x[i + step];
+			}
+			offset += 2 * count;
+		}
+
+		i32 top = 1;
+		while (2 * top <= n) {
+			top *= 2;
+		}
+		for (i32 step = top; step > 0; step /= 2) {
+			for (i32 j = step; j <= n; j += 2 * step) {
+				const f32* row = table.data() + 3 * (j - 1);
+				x[j] = (x[j] - row[0] * x[j - step] - row[1] * x[j + step]) * row[2];
+			}
+		}
+		std::copy(x.begin() + 1, x.begin() + n + 1, d);
+	}
+
+	gl::Buffer create_tridiagonal_buffer(const TridiagonalLine& line)
+	{
+		std::vector<f32> table = create_cyclic_reduction_table(line);
+		assert(cyclic_reduction_error(line, table) < 1e-3);
+
+		return gl::create_storage_buffer(table.size() * sizeof(f32), 0, table.data());
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <core.h>
+#include <gl-cxx/gl-res.h>
+#include <gl-cxx/gl-types.h>
+
+#include <vector>
+
+namespace dir2d
+{
+	// binding of the table buffer, must match TRIDIAGONAL_BINDING of shaders/tridiagonal.glsl
+	constexpr uint tridiagonal_binding = 8;
+
+	// max unknowns of a line solved on gpu, must match TRIDIAGONAL_MAX of shaders/tridiagonal.glsl
+	constexpr i32 tridiagonal_max = 4096;
+
+	// constant coefficient line a x_{i-1} + b x_i + c x_{i+1} = d_i of unknowns 1..n,
+	// x_0 and x_{n+1} are boundary values moved to d
+	struct TridiagonalLine
+	{
+		f64 a{};
+		f64 b{};
+		f64 c{};
+		i32 n{};
+	};
+
+	// thomas algorithm, d is replaced with x
+	void thomas_solve(const TridiagonalLine& line, f32* d);
+
+	// coefficients of cyclic reduction of the line, layout of shaders/tridiagonal.glsl
+	std::vector<f32> create_cyclic_reduction_table(const TridiagonalLine& line);
+
+	// cyclic reduction in the order of shaders/tridiagonal.glsl, d is replaced with x
+	void cyclic_reduction_solve(const TridiagonalLine& line, const std::vector<f32>& table, f32* d);
+
+	// table of the line uploaded for the programs including tridiagonal.glsl, checked against thomas algorithm in debug builds
+	gl::Buffer create_tridiagonal_buffer(const TridiagonalLine& line);
+}
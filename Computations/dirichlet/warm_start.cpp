@@ -0,0 +1,78 @@
+#include "warm_start.h"
+#include "dirichlet_util.h"
+#include "dirichlet_handle.h"
+
+#include <gl-cxx/gl-header.h>
+#include <gl-cxx/gl-res-util.h>
+
+#include <vector>
+#include <algorithm>
+
+namespace dir2d
+{
+	namespace
+	{
+		constexpr uint prolongate_workgroup_x = 16;
+		constexpr uint prolongate_workgroup_y = 16;
+	}
+
+	DomainAabb2D coarsen_domain(const DomainAabb2D& domain, i32 levels)
+	{
+		i32 xSplit = std::max(domain.xSplit >> levels, 2);
+		i32 ySplit = std::max(domain.ySplit >> levels, 2);
+		return DomainAabb2D::create_domain(domain.x0, domain.x1, domain.y0, domain.y1, xSplit, ySplit);
+	}
+
+	void prolongate(gl::Id program, gl::Id coarse, const DomainAabb2D& coarseDomain, const DomainAabb2D& fineDomain, DataAabb2D& fineData)
+	{
+		constexpr int IMG_COARSE = 0;
+		constexpr int IMG_FINE = 1;
+
+		i32 width  = fineDomain.xSplit + 1;
+		i32 height = fineDomain.ySplit + 1;
+
+		gl::Texture fine = gl::create_texture(width, height, GL_R32F);
+
+		glUseProgram(program);
+		glUniform2f(glGetUniformLocation(program, "scale"), (f32)coarseDomain.xSplit / fineDomain.xSplit, (f32)coarseDomain.ySplit / fineDomain.ySplit);
+		glBindImageTexture(IMG_COARSE, coarse, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+		glBindImageTexture(IMG_FINE, fine.id, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+
+		auto [numWorkgroupsX, numWorkgroupsY] = get_num_workgroups(fineDomain.xSplit, fineDomain.ySplit, prolongate_workgroup_x, prolongate_workgroup_y);
+		glDispatchCompute(numWorkgroupsX, numWorkgroupsY, 1);
+		glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+
+		std::vector<f32> values(width * height);
+		glGetTextureImage(fine.id, 0, GL_RED, GL_FLOAT, values.size() * sizeof(f32), values.data());
+
+		// boundary rows and columns are left as they are
+		for (i32 i = 1; i < height - 1; i++) {
+			auto first = values.begin() + i * width;
+			std::copy(first + 1, first + width - 1, fineData.solution.get() + i * width + 1);
+		}
+	}
+
+	DataAabb2D create_warm_data(Proxy& proxy, gl::Id program, const DomainAabb2D& domain, const Function2D& boundary, const Function2D& f, const WarmStart& warmStart)
+	{
+		DomainAabb2D currDomain = coarsen_domain(domain, warmStart.levels);
+		DataAabb2D currData = DataAabb2D::create_data(currDomain, boundary, f);
+		for (i32 level = warmStart.levels; level > 0; level--) {
+			ScopedHandle handle = proxy.createSmart(currDomain, currData, warmStart.params);
+			if (handle.empty()) {
+				return DataAabb2D::create_data(domain, boundary, f);
+			}
+
+			for (i32 i = 0; i < warmStart.updates; i++) {
+				proxy.update();
+			}
+
+			DomainAabb2D nextDomain = coarsen_domain(domain, level - 1);
+			DataAabb2D nextData = DataAabb2D::create_data(nextDomain, boundary, f);
+			prolongate(program, handle.texture(), currDomain, nextDomain, nextData);
+
+			currDomain = nextDomain;
+			currData = std::move(nextData);
+		}
+		return currData;
+	}
+}
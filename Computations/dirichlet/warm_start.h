@@ -0,0 +1,33 @@
+#pragma once
+
+#include <core.h>
+#include <gl-cxx/gl-types.h>
+
+#include "dirichlet-proxy.h"
+#include "dirichlet_cfg.h"
+#include "dirichlet_function.h"
+#include "dirichlet_dataaabb2d.h"
+#include "dirichlet_domainaabb2d.h"
+
+namespace dir2d
+{
+	// nested iteration: problem is solved on the domain coarsened 2^levels times first,
+	// each coarse solution is bilinearly prolongated and used as the initial guess on the next finer domain
+	struct WarmStart
+	{
+		i32 levels{};  // 0 - no warm start, interior starts at zero
+		i32 updates{}; // updates of the system on each coarse level
+		UpdateParams params{};
+	};
+
+	// the same region, split is halved levels times, at least 2 intervals are kept along each axis
+	DomainAabb2D coarsen_domain(const DomainAabb2D& domain, i32 levels);
+
+	// program - prolongate program, coarse - r32f texture of the coarse solution
+	// interior of fine data is replaced with the interpolated values, boundary values are kept
+	void prolongate(gl::Id program, gl::Id coarse, const DomainAabb2D& coarseDomain, const DomainAabb2D& fineDomain, DataAabb2D& fineData);
+
+	// coarse problems are solved by the system of the proxy, falls back to zero interior if they can't be created
+	// proxy updates all handles of the system, so warm data must be created before the other handles of the system
+	DataAabb2D create_warm_data(Proxy& proxy, gl::Id program, const DomainAabb2D& domain, const Function2D& boundary, const Function2D& f, const WarmStart& warmStart);
+}
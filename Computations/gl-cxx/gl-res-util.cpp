@@ -223,6 +223,25 @@ namespace gl
 		return texture;
 	}
 
+	Texture create_texture_3d(uint width, uint height, uint depth, GLenum format)
+	{
+		Texture texture{};
+
+		glCreateTextures(GL_TEXTURE_3D, 1, &texture.id);
+		if (!texture.valid()) {
+			return Texture{};
+		}
+
+		glTextureStorage3D(texture.id, 1, format, width, height, depth);
+		glTextureParameteri(texture.id, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTextureParameteri(texture.id, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTextureParameteri(texture.id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(texture.id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTextureParameteri(texture.id, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+		return texture;
+	}
+
 	Texture create_test_texture(uint width, uint height, uint period)
 	{
 		Texture texture = create_texture(width, height, GL_RGBA32F);
@@ -49,6 +49,8 @@ namespace gl
 
 	Texture create_texture(uint width, uint height, GLenum format);
 
+	Texture create_texture_3d(uint width, uint height, uint depth, GLenum format);
+
 	Texture create_test_texture(uint width, uint height, uint period);
 
 	Texture create_stencil_texture(uint width, uint height);
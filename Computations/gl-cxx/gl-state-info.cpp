@@ -1,6 +1,15 @@
 #include "gl-state-info.h"
 #include "gl-header.h"
 
+#include <cstring>
+
+#ifndef GL_KHR_shader_subgroup
+	#define GL_SUBGROUP_SIZE_KHR 0x9532
+	#define GL_SUBGROUP_SUPPORTED_STAGES_KHR 0x9533
+	#define GL_SUBGROUP_SUPPORTED_FEATURES_KHR 0x9534
+	#define GL_SUBGROUP_FEATURE_SHUFFLE_BIT_KHR 0x00000010
+#endif
+
 namespace gl
 {
 	void GlStateInfo::acquireInfo()
@@ -25,6 +34,12 @@ namespace gl
 		glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_SIZE, 0, maxComputeWorkgroupSize);
 		glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_SIZE, 1, maxComputeWorkgroupSize + 1);
 		glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_SIZE, 2, maxComputeWorkgroupSize + 2);
+
+		if (hasExtension("GL_KHR_shader_subgroup")) {
+			glGetIntegerv(GL_SUBGROUP_SIZE_KHR, &subgroupSize);
+			glGetIntegerv(GL_SUBGROUP_SUPPORTED_STAGES_KHR, &subgroupSupportedStages);
+			glGetIntegerv(GL_SUBGROUP_SUPPORTED_FEATURES_KHR, &subgroupSupportedFeatures);
+		}
 	}
 
 	const GLubyte* GlStateInfo::vendor() const
@@ -42,6 +57,26 @@ namespace gl
 		return glGetString(GL_VERSION);
 	}
 
+	bool GlStateInfo::hasExtension(const char* name) const
+	{
+		GLint numExtensions{};
+		glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+		for (GLint i = 0; i < numExtensions; i++) {
+			auto extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+			if (extension && std::strcmp(extension, name) == 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool GlStateInfo::subgroupShuffleSupported() const
+	{
+		return subgroupSize > 1
+			&& (subgroupSupportedStages & GL_COMPUTE_SHADER_BIT) != 0
+			&& (subgroupSupportedFeatures & GL_SUBGROUP_FEATURE_SHUFFLE_BIT_KHR) != 0;
+	}
+
 	void GlStateInfo::printAll(std::ostream& out)
 	{
 		out << "*** OpenGL context info ***" << std::endl;
@@ -66,5 +101,9 @@ namespace gl
 		out << "max compute workgroup size x:" << maxComputeWorkgroupSize[0] << std::endl;
 		out << "max compute workgroup size y:" << maxComputeWorkgroupSize[1] << std::endl;
 		out << "max compute workgroup size z:" << maxComputeWorkgroupSize[2] << std::endl;
+		out << std::endl;
+		out << "subgroup size: " << subgroupSize << std::endl;
+		out << "subgroup supported stages: " << subgroupSupportedStages << std::endl;
+		out << "subgroup supported features: " << subgroupSupportedFeatures << std::endl;
 	}
 }
@@ -17,6 +17,10 @@ namespace gl
 
 		const GLubyte* version() const;
 
+		bool hasExtension(const char* name) const;
+
+		bool subgroupShuffleSupported() const;
+
 		void printAll(std::ostream& out);
 
 
@@ -34,5 +38,10 @@ namespace gl
 		GLint maxComputeShaderWorkgroupInvocations{};
 		GLint maxComputeWorkgroupCount[3]{};
 		GLint maxComputeWorkgroupSize[3]{};	
+
+		// GL_KHR_shader_subgroup, zeros if extension is not supported
+		GLint subgroupSize{};
+		GLint subgroupSupportedStages{};
+		GLint subgroupSupportedFeatures{};
 	};
 }
@@ -5,14 +5,62 @@
 
 #include <memory>
 #include <sstream>
+#include <string>
+#include <vector>
+#include <functional>
 
-void test_tiled(const std::vector<std::string>& systems,
-				uint width,
-				const std::vector<uint>& splitValues,
-				const std::vector<uint>& stepValues,
-				const std::vector<uint>& workValues,
-				const std::string& outputPrefix,
-				uint updates)
+// point of a sweep axis: its part of the output name and its change of the builder
+struct SweepPoint
+{
+	std::string label;
+	std::function<void(ConfigBuilder&)> apply;
+};
+
+using SweepAxis = std::vector<SweepPoint>;
+
+// one point per value, label is the value unless a label function is given
+template<class T, class Apply>
+SweepAxis make_axis(const std::vector<T>& values, Apply apply)
+{
+	SweepAxis axis;
+	for (const T& value : values) {
+		std::ostringstream label;
+		label << value;
+		axis.push_back({label.str(), [value, apply](ConfigBuilder& builder) { apply(builder, value); }});
+	}
+	return axis;
+}
+
+template<class T, class Apply, class Label>
+SweepAxis make_axis(const std::vector<T>& values, Apply apply, Label label)
+{
+	SweepAxis axis;
+	for (const T& value : values) {
+		axis.push_back({label(value), [value, apply](ConfigBuilder& builder) { apply(builder, value); }});
+	}
+	return axis;
+}
+
+// square grids
+SweepAxis split_axis(const std::vector<uint>& values)
+{
+	return make_axis(values, [](ConfigBuilder& builder, uint split) {
+		builder.setSplitX(split);
+		builder.setSplitY(split);
+	});
+}
+
+// square workgroups
+SweepAxis work_axis(const std::vector<uint>& values)
+{
+	return make_axis(values, [](ConfigBuilder& builder, uint work) {
+		builder.setWorkgroupSizeX(work);
+		builder.setWorkgroupSizeY(work);
+	});
+}
+
+// systems side by side, options shared by all points of a sweep are set on the builder before the sweep
+ConfigBuilder create_sweep_builder(const std::vector<std::string>& systems, uint width, uint updates)
 {
 	ConfigBuilder builder;
 	builder.setSystems(systems);
@@ -21,105 +69,391 @@ void test_tiled(const std::vector<std::string>& systems,
 	builder.setWindowWidth(width * systems.size());
 	builder.setWindowHeight(width);
 	builder.setTotalUpdates(updates);
-	for (auto split : splitValues) {
-		for (auto step : stepValues) {
-			for (auto work : workValues) {
-				std::ostringstream output;
-				output << outputPrefix << split << "_" << step << "_" << work << ".json";
-
-				builder.setSteps(step);
-				builder.setSplitX(split);
-				builder.setSplitY(split);
-				builder.setWorkgroupSizeX(work);
-				builder.setWorkgroupSizeY(work);
-				builder.setOutput(output.str());
-
-				auto application = std::make_unique<app::App>(builder.build());
-				application->mainloop();
-			}
-		}
-	}
+	return builder;
 }
 
-void test_non_tiled(const std::vector<std::string>& systems,
-				 uint width,
-				 const std::vector<uint>& splitValues,
-				 const std::vector<uint>& workValues,
-				 const std::string& outputPrefix,
-				 uint updates)
+// runs the app for every point of the product of the axes, the first axis is the outermost loop
+// output is outputPrefix + labels of the point joined by '_' + ".json"
+void sweep(ConfigBuilder& builder, const std::vector<SweepAxis>& axes, const std::string& outputPrefix, size_t axis = 0, const std::string& name = "")
 {
-	ConfigBuilder builder;
-	builder.setSystems(systems);
-	builder.setGridX(1);
-	builder.setGridY(1);
-	builder.setWindowWidth(width);
-	builder.setWindowHeight(width);
-	builder.setTotalUpdates(updates);
-	for (auto split : splitValues) {
-		for (auto work : workValues) {
-			std::ostringstream output;
-			output << outputPrefix << split << "_" << work << ".json";
-
-			builder.setSplitX(split);
-			builder.setSplitY(split);
-			builder.setWorkgroupSizeX(work);
-			builder.setWorkgroupSizeY(work);
-			builder.setOutput(output.str());
-
-			auto application = std::make_unique<app::App>(builder.build());
-			application->mainloop();
-		}
+	if (axis == axes.size()) {
+		builder.setOutput(outputPrefix + name + ".json");
+
+		auto application = std::make_unique<app::App>(builder.build());
+		application->mainloop();
+		return;
+	}
+
+	for (auto& point : axes[axis]) {
+		point.apply(builder);
+		sweep(builder, axes, outputPrefix, axis + 1, name.empty() ? point.label : name + "_" + point.label);
 	}
 }
 
 void test_rb_tiled()
 {
-	test_tiled({"red_black_tiled", "red_black_smtm", "red_black_smtm_s"},
-			   512,
-			   {255, 511, 1023},
-			   {3, 4, 5},
-			   {16, 24, 32},
-			   "tests/tiled/test_",
-			   1000);
+	ConfigBuilder builder = create_sweep_builder({"red_black_tiled", "red_black_smtm", "red_black_smtm_s", "red_black_smtm_df"}, 512, 1000);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   make_axis<uint>({3, 4, 5}, [](ConfigBuilder& b, uint steps) { b.setSteps(steps); }),
+		   work_axis({16, 24, 32})},
+		  "tests/tiled/test_");
+}
+
+// diamond tiles need 4 * steps < workgroup, so 16 x 16 workgroups are left out
+void test_rb_diamond()
+{
+	ConfigBuilder builder = create_sweep_builder({"red_black_tiled", "red_black_diamond"}, 512, 1000);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   make_axis<uint>({3, 4, 5}, [](ConfigBuilder& b, uint steps) { b.setSteps(steps); }),
+		   work_axis({24, 32})},
+		  "tests/diamond/test_");
 }
 
 void test_chaotic()
 {
-	test_tiled({"chaotic_tiled", "chaotic_smtm"},
-			   512,
-			   {255, 511, 1023},
-			   {3, 4, 5},
-			   {12, 16, 20},
-			   "tests/chaotic/test_",
-			   1000);
+	ConfigBuilder builder = create_sweep_builder({"chaotic_tiled", "chaotic_smtm", "chaotic_smtm_df"}, 512, 1000);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   make_axis<uint>({3, 4, 5}, [](ConfigBuilder& b, uint steps) { b.setSteps(steps); }),
+		   work_axis({12, 16, 20})},
+		  "tests/chaotic/test_");
 }
 
 void test_rb()
 {
-	test_non_tiled({"red_black"},
-				   512,
-				   {255, 511, 1023},
-				   {16, 24, 32},
-				   "tests/rb/test_",
-				   1000);
+	ConfigBuilder builder = create_sweep_builder({"red_black"}, 512, 1000);
+	// systems share one view
+	builder.setGridX(1);
+	builder.setWindowWidth(512);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   work_axis({16, 24, 32})},
+		  "tests/rb/test_");
+}
+
+void test_rb_persistent()
+{
+	ConfigBuilder builder = create_sweep_builder({"red_black_persistent"}, 512, 1000);
+	// systems share one view
+	builder.setGridX(1);
+	builder.setWindowWidth(512);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   work_axis({8, 16, 32})},
+		  "tests/rb_persistent/test_");
 }
 
 void test_jacoby()
 {
-	test_non_tiled({"jacoby"},
-				   512,
-				   {255, 511, 1023},
-				   {12, 16, 20},
-				   "tests/jacoby/test_",
-				   1000);
+	ConfigBuilder builder = create_sweep_builder({"jacoby"}, 512, 1000);
+	// systems share one view
+	builder.setGridX(1);
+	builder.setWindowWidth(512);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   work_axis({12, 16, 20})},
+		  "tests/jacoby/test_");
+}
+
+// local size is the tile overlapped by steps(steps + 1 for jacoby_smtm) on each side, 20 + 2 * 6 is the largest one fitting 1024 invocations
+void test_jacoby_tiled()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby_tiled", "jacoby_smtm"}, 512, 1000);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   make_axis<uint>({3, 4, 5}, [](ConfigBuilder& b, uint steps) { b.setSteps(steps); }),
+		   work_axis({16, 20})},
+		  "tests/jacoby_tiled/test_");
+}
+
+void test_coarsened()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby_coarse", "red_black_coarse"}, 512, 1000);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   make_axis<uint>({2, 4, 8}, [](ConfigBuilder& b, uint coarsen) { b.setCoarsen(coarsen); }),
+		   work_axis({16, 32})},
+		  "tests/coarse/test_");
+}
+
+void test_rb_coloured()
+{
+	ConfigBuilder builder = create_sweep_builder({"red_black_smtm_mc"}, 512, 1000);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   make_axis<uint>({4, 9}, [](ConfigBuilder& b, uint colours) { b.setColours(colours); }),
+		   make_axis<uint>({3, 4, 5}, [](ConfigBuilder& b, uint steps) { b.setSteps(steps); }),
+		   work_axis({16, 24, 32})},
+		  "tests/rb_coloured/test_");
+}
+
+void test_cache_layouts()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby", "red_black", "red_black_tiled", "red_black_smtm"}, 512, 1000);
+	builder.setSteps(4);
+	sweep(builder,
+		  {split_axis({1023}),
+		   make_axis<std::string>({"column_major", "row_major", "padded", "xor"}, [](ConfigBuilder& b, const std::string& layout) { b.setCacheLayout(layout); }),
+		   work_axis({16, 24, 32})},
+		  "tests/cache_layout/test_");
+}
+
+// unpadded grids against grids with ghost layers covering the overlap(2 * steps), unaligned and aligned splits
+void test_ghosts()
+{
+	ConfigBuilder builder = create_sweep_builder({"red_black_smtm"}, 512, 1000);
+	builder.setSteps(4);
+	builder.setStorageSsbo(true);
+	sweep(builder,
+		  {split_axis({1000, 1023}),
+		   make_axis<uint>({0, 8}, [](ConfigBuilder& b, uint ghost) { b.setStorageGhost(ghost); }),
+		   work_axis({16, 32})},
+		  "tests/ghost/test_");
+}
+
+// f grid against f evaluated in programs, expression mirrors f of app.cpp
+void test_analytic_rhs()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby_tiled", "red_black_tiled", "red_black_smtm"}, 512, 1000);
+	builder.setSteps(4);
+	sweep(builder,
+		  {split_axis({1023, 2047, 4095}),
+		   make_axis<std::string>({"", "4.0 * (x * x + y * y - 1.0) * exp(-(x * x + y * y))"}, [](ConfigBuilder& b, const std::string& rhs) { b.setRhsExpression(rhs); }, [](const std::string& rhs) { return std::string(rhs.empty() ? "grid" : "analytic"); }),
+		   work_axis({16, 24})},
+		  "tests/rhs/test_");
+}
+
+// cost of the fused residual: plain programs against the ones accumulating max |u_new - u_old|
+void test_fused_residual()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby", "jacoby_tiled", "red_black", "red_black_tiled"}, 512, 1000);
+	builder.setSteps(4);
+	sweep(builder,
+		  {split_axis({1023, 2047, 4095}),
+		   make_axis<bool>({false, true}, [](ConfigBuilder& b, bool residual) { b.setResidual(residual); }, [](bool residual) { return std::string(residual ? "residual" : "plain"); }),
+		   work_axis({16, 24})},
+		  "tests/residual/test_");
+}
+
+// cold start against nested iteration over 2, 4 and 8 x coarsened grids, residual shows the error left after the same updates
+void test_warm_start()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby", "red_black", "red_black_tiled"}, 512, 1000);
+	builder.setSteps(4);
+	builder.setResidual(true);
+	builder.setWarmStartUpdates(200);
+	sweep(builder,
+		  {split_axis({1023, 2047, 4095}),
+		   make_axis<uint>({0, 1, 2, 3}, [](ConfigBuilder& b, uint levels) { b.setWarmStartLevels(levels); })},
+		  "tests/warm/test_");
+}
+
+// one problem per handle against 4 problems packed into rgba channels, time per problem is elapsed / channels
+void test_packed_channels()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby", "red_black"}, 512, 1000);
+	sweep(builder,
+		  {split_axis({1023, 2047, 4095}),
+		   make_axis<uint>({1, 4}, [](ConfigBuilder& b, uint channels) { b.setChannels(channels); }),
+		   work_axis({16, 32})},
+		  "tests/channels/test_");
+}
+
+// whole box against masked l-shaped and perforated domains, tiles of the cut quadrant of l_shape are not dispatched
+void test_masked_domains()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby", "red_black"}, 512, 1000);
+	sweep(builder,
+		  {split_axis({1023, 2047, 4095}),
+		   make_axis<std::string>({"box", "l_shape", "perforated"}, [](ConfigBuilder& b, const std::string& shape) { b.setShape(shape); }),
+		   work_axis({16, 32})},
+		  "tests/shape/test_");
+}
+
+// constant coefficient against k staged in shared memory alongside u
+void test_variable_coefficient()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby", "jacoby_tiled", "red_black"}, 512, 1000);
+	builder.setSteps(4);
+	sweep(builder,
+		  {split_axis({1023, 2047, 4095}),
+		   make_axis<std::string>({"constant", "layered", "checker"}, [](ConfigBuilder& b, const std::string& coefficient) { b.setCoefficient(coefficient); }),
+		   work_axis({16, 24})},
+		  "tests/coefficient/test_");
+}
+
+// dirichlet edges against neumann and robin edges updated by the sweep itself, edge tiles take the boundary branches
+void test_boundary_conditions()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby", "jacoby_tiled", "red_black", "red_black_tiled", "red_black_smtm"}, 512, 1000);
+	builder.setSteps(4);
+	sweep(builder,
+		  {split_axis({1023, 2047, 4095}),
+		   make_axis<std::string>({"dirichlet", "neumann", "robin", "mixed"}, [](ConfigBuilder& b, const std::string& boundary) { b.setBoundary(boundary); }),
+		   work_axis({16, 24})},
+		  "tests/boundary/test_");
+}
+
+// 5-point jacoby and red-black against fourth order 9-point ones, 4 x coarser grids are enough for the same accuracy
+void test_fourth_order()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby", "red_black"}, 512, 1000);
+	// systems share one view
+	builder.setGridX(1);
+	builder.setWindowWidth(512);
+	sweep(builder,
+		  {split_axis({1023, 2047, 4095}),
+		   work_axis({16, 32})},
+		  "tests/mehrstellen/test_5_");
+	builder = create_sweep_builder({"jacoby_mehrstellen", "red_black_mehrstellen"}, 512, 1000);
+	// systems share one view
+	builder.setGridX(1);
+	builder.setWindowWidth(512);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   work_axis({16, 32})},
+		  "tests/mehrstellen/test_9_");
+}
+
+// implicit steps warm started from the previous one against explicit forward euler making steps time steps per dispatch,
+// explicit time step is bounded by h^2 / 4, so it is compared with jacoby_tiled sweeping the same tiles
+void test_heat()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby", "jacoby_tiled", "red_black", "red_black_tiled", "red_black_smtm"}, 512, 100);
+	// each update is one implicit time step, the system is updated setStepUpdates times per step
+	builder.setSteps(4);
+	builder.setTimeStep(0.01f);
+	builder.setStepUpdates(50);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   make_axis<std::string>({"backward_euler", "crank_nicolson"}, [](ConfigBuilder& b, const std::string& time) { b.setTime(time); }),
+		   work_axis({16, 24})},
+		  "tests/heat/test_");
+	builder = create_sweep_builder({"jacoby_tiled", "heat_tiled"}, 512, 1000);
+	// 16 + 2 * 8 is the largest overlapped tile fitting 1024 invocations
+	builder.setWorkgroupSizeX(16);
+	builder.setWorkgroupSizeY(16);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   make_axis<uint>({2, 4, 8}, [](ConfigBuilder& b, uint steps) { b.setSteps(steps); })},
+		  "tests/heat/explicit_");
+}
+
+// smoothers of the tiled kernels against bicgstab on convection-diffusion problems,
+// central differences lose positive weights at |b| h / 2 > 1, so the smoothers are expected to diverge on coarse grids at high velocity
+void test_convection_diffusion()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby_tiled", "red_black_tiled", "bicgstab"}, 512, 1000);
+	// b = (velocity, velocity), residual of bicgstab is the 2-norm of f - Au, the others track max |u_new - u_old|
+	builder.setSteps(4);
+	builder.setResidual(true);
+	builder.setWorkgroupSizeX(16);
+	builder.setWorkgroupSizeY(16);
+	sweep(builder,
+		  {split_axis({255, 511, 1023}),
+		   make_axis<std::string>({"central", "upwind"}, [](ConfigBuilder& b, const std::string& convection) { b.setConvection(convection); }),
+		   make_axis<f32>({10.0f, 100.0f, 1000.0f}, [](ConfigBuilder& b, f32 velocity) { b.setVelocity(velocity); })},
+		  "tests/convection/test_");
+}
+
+// point red-black against zebra line sor and adi on stretched grids(hx << hy), line solves handle the strong coupling along x
+void test_line_relaxation()
+{
+	ConfigBuilder builder = create_sweep_builder({"red_black", "line_zebra", "adi"}, 512, 1000);
+	builder.setResidual(true);
+	builder.setWorkgroupSizeX(16);
+	builder.setWorkgroupSizeY(16);
+	sweep(builder,
+		  {make_axis<uint>({1023, 2047, 4095}, [](ConfigBuilder& b, uint xSplit) { b.setSplitX(xSplit); }),
+		   make_axis<uint>({63, 255, 1023}, [](ConfigBuilder& b, uint ySplit) { b.setSplitY(ySplit); })},
+		  "tests/lines/test_");
+}
+
+// 3d jacoby and red-black against temporally tiled red-black, halo of thin workgroups costs more
+void test_3d()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby_3d", "red_black_3d", "red_black_tiled_3d"}, 512, 1000);
+	builder.setSteps(2);
+	// 16 x 16 x 8 exceeds 1024 invocations, so the deepest workgroups are 8 x 8 only
+	sweep(builder,
+		  {make_axis<uint>({63, 127, 255}, [](ConfigBuilder& b, uint split) { b.setSplitX(split); b.setSplitY(split); b.setSplitZ(split); }),
+		   work_axis({8}),
+		   make_axis<uint>({2, 4, 8}, [](ConfigBuilder& b, uint workZ) { b.setWorkgroupSizeZ(workZ); })},
+		  "tests/volume/test_");
+	sweep(builder,
+		  {make_axis<uint>({63, 127, 255}, [](ConfigBuilder& b, uint split) { b.setSplitX(split); b.setSplitY(split); b.setSplitZ(split); }),
+		   work_axis({16}),
+		   make_axis<uint>({2, 4}, [](ConfigBuilder& b, uint workZ) { b.setWorkgroupSizeZ(workZ); })},
+		  "tests/volume/test_");
+}
+
+// 32 x work tiles of jacoby and red_black against strips of the same width marching work rows per step
+void test_streamed()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby", "jacoby_stream", "red_black", "red_black_stream"}, 512, 1000);
+	builder.setWorkgroupSizeX(32);
+	sweep(builder,
+		  {split_axis({1023, 2047, 4095}),
+		   make_axis<uint>({64, 128, 256}, [](ConfigBuilder& b, uint rows) { b.setStreamRows(rows); }),
+		   make_axis<uint>({8, 16, 32}, [](ConfigBuilder& b, uint work) { b.setWorkgroupSizeY(work); })},
+		  "tests/stream/test_");
+}
+
+void test_tiled_strided()
+{
+	ConfigBuilder builder = create_sweep_builder({"jacoby_tiled_strided", "red_black_tiled_strided"}, 512, 1000);
+	builder.setWorkgroupSizeX(16);
+	builder.setWorkgroupSizeY(16);
+	sweep(builder,
+		  {split_axis({511, 1023, 2047}),
+		   make_axis<uint>({32, 48, 64}, [](ConfigBuilder& b, uint tile) { b.setTileSizeX(tile); b.setTileSizeY(tile); }),
+		   make_axis<uint>({4, 8}, [](ConfigBuilder& b, uint steps) { b.setSteps(steps); })},
+		  "tests/tiled_strided/test_");
+}
+
+void test_swizzled()
+{
+	ConfigBuilder builder = create_sweep_builder({"red_black", "red_black_tiled", "red_black_smtm", "red_black_diamond"}, 512, 1000);
+	builder.setSteps(4);
+	builder.setWorkgroupSizeX(32);
+	builder.setWorkgroupSizeY(32);
+	sweep(builder,
+		  {split_axis({1023, 2047}),
+		   make_axis<std::string>({"row_major", "morton", "hilbert", "band"}, [](ConfigBuilder& b, const std::string& swizzle) { b.setSwizzle(swizzle); }),
+		   make_axis<uint>({4, 8, 16}, [](ConfigBuilder& b, uint block) { b.setSwizzleBlock(block); })},
+		  "tests/swizzle/test_");
 }
 
 void test_all()
 {
 	test_rb_tiled();
+	test_rb_diamond();
 	test_chaotic();
 	test_rb();
+	test_rb_persistent();
+	test_rb_coloured();
 	test_jacoby();
+	test_jacoby_tiled();
+	test_coarsened();
+	test_streamed();
+	test_tiled_strided();
+	test_cache_layouts();
+	test_swizzled();
+	test_ghosts();
+	test_analytic_rhs();
+	test_fused_residual();
+	test_warm_start();
+	test_packed_channels();
+	test_masked_domains();
+	test_variable_coefficient();
+	test_3d();
+	test_boundary_conditions();
+	test_fourth_order();
+	test_heat();
+	test_convection_diffusion();
+	test_line_relaxation();
 }
 
 void custom_test()
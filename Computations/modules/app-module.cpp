@@ -16,10 +16,22 @@ ModulePtr AppModuleBuilder::build(Module& root, const cfg::json& config)
 		AppParams{
 			.xSplit = appConfig["x_split"].get<uint>(),
 			.ySplit = appConfig["y_split"].get<uint>(),
+			.zSplit = appConfig["z_split"].get<uint>(),
 			.totalUpdates = appConfig["total_updates"].get<uint>(),
 			.itersPerUpdate = appConfig["iters_per_update"].get<uint>(),
 			.gridX = appConfig["grid_x"].get<uint>(),
 			.gridY = appConfig["grid_y"].get<uint>(),
+			.warmStartLevels = appConfig["warm_start_levels"].get<uint>(),
+			.warmStartUpdates = appConfig["warm_start_updates"].get<uint>(),
+			.channels = appConfig["channels"].get<uint>(),
+			.shape = appConfig["shape"].get<std::string>(),
+			.coefficient = appConfig["coefficient"].get<std::string>(),
+			.boundary = appConfig["boundary"].get<std::string>(),
+			.time = appConfig["time"].get<std::string>(),
+			.timeStep = appConfig["time_step"].get<f32>(),
+			.stepUpdates = appConfig["step_updates"].get<uint>(),
+			.convection = appConfig["convection"].get<std::string>(),
+			.velocity = appConfig["velocity"].get<f32>(),
 		}
 	);
 
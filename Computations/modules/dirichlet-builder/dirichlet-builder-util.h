@@ -5,6 +5,8 @@
 #include <program-storage.h>
 #include <dirichlet-params.h>
 
+#include <gl-cxx/gl-state-info.h>
+#include <dirichlet/grid_storage.h>
 #include <dirichlet/dirichlet-proxy.h>
 
 #include "../module.h"
@@ -12,6 +14,8 @@
 #include <string>
 #include <exception>
 #include <tuple>
+#include <initializer_list>
+#include <utility>
 
 #define LAZY_CPP_EVASION inline
 
@@ -61,6 +65,147 @@ const json& try_get_value(const json& js, const json::json_pointer& key)
 	return js[key];
 }
 
+LAZY_CPP_EVASION
+dir2d::StorageType get_storage_type(const json& shaderConfig)
+{
+	if (shaderConfig.contains("macros") && shaderConfig["macros"].contains("_STORAGE_SSBO"))
+	{
+		return dir2d::StorageType::Buffer;
+	}
+	return dir2d::StorageType::Texture;
+}
+
+// ghost layers of padded buffer storage, 0 if grids are not padded
+LAZY_CPP_EVASION
+int get_storage_ghost(const json& shaderConfig)
+{
+	if (shaderConfig.contains("macros") && shaderConfig["macros"].contains("_STORAGE_GHOST"))
+	{
+		return parse_value<int>(shaderConfig["macros"], "_STORAGE_GHOST");
+	}
+	return 0;
+}
+
+// channels of the grids, 1 if problems are not packed
+LAZY_CPP_EVASION
+int get_grid_channels(const json& shaderConfig)
+{
+	if (shaderConfig.contains("macros") && shaderConfig["macros"].contains("_GRID_CHANNELS"))
+	{
+		return parse_value<int>(shaderConfig["macros"], "_GRID_CHANNELS");
+	}
+	return 1;
+}
+
+// true if program reads cell mask of non-rectangular domains
+LAZY_CPP_EVASION
+bool has_mask(const json& shaderConfig)
+{
+	return shaderConfig.contains("macros") && shaderConfig["macros"].contains("_MASK");
+}
+
+// true if program solves variable coefficient problems
+LAZY_CPP_EVASION
+bool has_coefficient(const json& shaderConfig)
+{
+	return shaderConfig.contains("macros") && shaderConfig["macros"].contains("_COEF");
+}
+
+// true if program updates neumann and robin edges
+LAZY_CPP_EVASION
+bool has_boundary(const json& shaderConfig)
+{
+	return shaderConfig.contains("macros") && shaderConfig["macros"].contains("_BOUNDARY");
+}
+
+// true if program solves shifted(helmholtz) problems of implicit time steps
+LAZY_CPP_EVASION
+bool has_shift(const json& shaderConfig)
+{
+	return shaderConfig.contains("macros") && shaderConfig["macros"].contains("_SHIFT");
+}
+
+// true if program solves convection-diffusion problems
+LAZY_CPP_EVASION
+bool has_convection(const json& shaderConfig)
+{
+	return shaderConfig.contains("macros") && shaderConfig["macros"].contains("_CONVECTION");
+}
+
+// subgroup variants are scalar, don't read cell mask, solve constant coefficient poisson problems with dirichlet edges only
+LAZY_CPP_EVASION
+bool subgroup_compatible(const json& shaderConfig)
+{
+	return get_grid_channels(shaderConfig) == 1 && !has_mask(shaderConfig) && !has_coefficient(shaderConfig) && !has_boundary(shaderConfig)
+		&& !has_shift(shaderConfig) && !has_convection(shaderConfig);
+}
+
+// number of points updated by one invocation along y, 1 if program is not coarsened
+LAZY_CPP_EVASION
+uint get_coarsen(const json& shaderConfig)
+{
+	if (shaderConfig.contains("macros") && shaderConfig["macros"].contains("_COARSEN"))
+	{
+		return parse_value<uint>(shaderConfig["macros"], "_COARSEN");
+	}
+	return 1;
+}
+
+// size of the tile covered by one workgroup: strided and streaming programs set it independently of the local size
+// axes without a tile macro are covered by the local size
+LAZY_CPP_EVASION
+std::tuple<uint, uint> get_tile_size(const json& shaderConfig)
+{
+	auto& macros = try_get_value(shaderConfig, "macros");
+	uint tileX = parse_value<uint>(macros, macros.contains("_TILE_X") ? "_TILE_X" : "_WORKGROUP_X");
+	uint tileY = parse_value<uint>(macros, macros.contains("_TILE_Y") ? "_TILE_Y" : "_WORKGROUP_Y");
+	return {tileX, tileY};
+}
+
+// number of tile colours of multi-colour programs
+LAZY_CPP_EVASION
+uint get_colours(const json& shaderConfig)
+{
+	return parse_value<uint>(try_get_value(shaderConfig, "macros"), "_COLOURS");
+}
+
+// subgroup variants are used only if device supports shuffles in compute shaders and all of them were built
+// support is queried once, every builder runs in the same context
+LAZY_CPP_EVASION
+bool use_subgroup_programs(ProgramStorage& storage, std::initializer_list<std::string> progs)
+{
+	static const bool supported = [] ()
+	{
+		gl::GlStateInfo info;
+		info.acquireInfo();
+		return info.subgroupShuffleSupported();
+	}();
+	if (!supported)
+	{
+		return false;
+	}
+
+	for (auto& prog : progs)
+	{
+		if (!storage.has(prog))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// reduce program of residual partials, residual isn't tracked if it wasn't built
+LAZY_CPP_EVASION
+gl::Id get_residual_program(ProgramStorage& storage)
+{
+	if (!storage.has("residual_reduce"))
+	{
+		return gl::null;
+	}
+	return get_shader_program(storage, "residual_reduce");
+}
+
 LAZY_CPP_EVASION
 ModulePtr try_get_module(Module& root, const std::string& name)
 {
@@ -95,22 +240,25 @@ std::tuple<ModulePtr, ModulePtr> try_get_dirichlet_parts(Module& root)
 						try_get_module(*dirichlet, "controls"));
 }
 
-template<class System>
+// extra args are passed to the system constructor after the storage type
+template<class System, class ... Args>
 ModulePtr create_one_shader_sys(Module& systems,
 								Module& controls,
 								ProgramStorage& storage,
 								const json& config,
 								const std::string& name,
-								const std::string& prog)
+								const std::string& prog,
+								Args&& ... args)
 {
 	auto& systemConfig = try_get_value(config, json::json_pointer("/dirichlet/" + name));
 	auto& shaderConfig = try_get_value(config, json::json_pointer("/shader_storage/shaders/" + prog + ".comp"));
 
-	uint workgroupX = parse_value<uint>(shaderConfig["macros"], "_WORKGROUP_X");
-	uint workgroupY = parse_value<uint>(shaderConfig["macros"], "_WORKGROUP_Y");
+	auto [workgroupX, workgroupY] = get_tile_size(shaderConfig);
+	uint coarsen = get_coarsen(shaderConfig); // coarsened programs cover coarsen rows per invocation, system sees the whole tile
+	dir2d::StorageType storageType = get_storage_type(shaderConfig);
 	gl::Id programId = get_shader_program(storage, prog);
 
-	ModulePtr systemModule = std::make_shared<Module>(placeholder_t<System>, workgroupX, workgroupY, programId);
+	ModulePtr systemModule = std::make_shared<Module>(placeholder_t<System>, workgroupX, workgroupY * coarsen, programId, storageType, std::forward<Args>(args)...);
 	try_load_module(systems, systemModule, name);
 
 	ModulePtr systemProxy = std::make_shared<Module>(placeholder_t<dir2d::Proxy>, systemModule->get<System>());
@@ -119,14 +267,16 @@ ModulePtr create_one_shader_sys(Module& systems,
 	return systemModule;
 }
 
-template<class System>
+// extra args are passed to the system constructor after the storage type
+template<class System, class ... Args>
 ModulePtr create_two_shader_sys(Module& systems,
 								Module& controls,
 								ProgramStorage& storage,
 								const json& config,
 								const std::string& name,
 								const std::string& prog0,
-								const std::string& prog1)
+								const std::string& prog1,
+								Args&& ... args)
 {
 	auto& systemConfig = try_get_value(config, json::json_pointer("/dirichlet/" + name));
 	auto& shaderConfig0 = try_get_value(config, json::json_pointer("/shader_storage/shaders/" + prog0 + ".comp"));
@@ -145,11 +295,45 @@ ModulePtr create_two_shader_sys(Module& systems,
 		throw std::runtime_error("Invalid workgroup dimensions specified: they must be equal in both programs.");
 	}
 
-	ModulePtr systemModule = std::make_shared<Module>(placeholder_t<System>, workgroupX0, workgroupY0, programId0, programId1);
+	dir2d::StorageType storageType = get_storage_type(shaderConfig0);
+	if (storageType != get_storage_type(shaderConfig1))
+	{
+		throw std::runtime_error("Invalid storage specified: it must be the same in both programs.");
+	}
+
+	ModulePtr systemModule = std::make_shared<Module>(placeholder_t<System>, workgroupX0, workgroupY0, programId0, programId1, storageType, std::forward<Args>(args)...);
 	try_load_module(systems, systemModule, name);
 
 	ModulePtr systemProxy = std::make_shared<Module>(placeholder_t<dir2d::Proxy>, systemModule->get<System>());
 	try_load_module(controls, systemProxy, name);
 
+	return systemModule;
+}
+
+// 3d systems take workgroup size along z, they use texture storage only
+template<class System, class ... Args>
+ModulePtr create_volume_sys(Module& systems,
+							Module& controls,
+							ProgramStorage& storage,
+							const json& config,
+							const std::string& name,
+							const std::string& prog,
+							Args&& ... args)
+{
+	auto& systemConfig = try_get_value(config, json::json_pointer("/dirichlet/" + name));
+	auto& shaderConfig = try_get_value(config, json::json_pointer("/shader_storage/shaders/" + prog + ".comp"));
+
+	auto& macros = try_get_value(shaderConfig, "macros");
+	uint workgroupX = parse_value<uint>(macros, "_WORKGROUP_X");
+	uint workgroupY = parse_value<uint>(macros, "_WORKGROUP_Y");
+	uint workgroupZ = parse_value<uint>(macros, "_WORKGROUP_Z");
+	gl::Id programId = get_shader_program(storage, prog);
+
+	ModulePtr systemModule = std::make_shared<Module>(placeholder_t<System>, workgroupX, workgroupY, workgroupZ, programId, std::forward<Args>(args)...);
+	try_load_module(systems, systemModule, name);
+
+	ModulePtr systemProxy = std::make_shared<Module>(placeholder_t<dir3d::Proxy>, systemModule->get<System>());
+	try_load_module(controls, systemProxy, name);
+
 	return systemModule;
 }
\ No newline at end of file
@@ -3,13 +3,26 @@
 #include "dirichlet-builders.h"
 
 #include <dirichlet/jacoby.h>
+#include <dirichlet/jacoby_smtm.h>
 #include <dirichlet/red_black.h>
+#include <dirichlet/red_black_persistent.h>
 #include <dirichlet/chaotic_smtm.h>
+#include <dirichlet/chaotic_smtm_df.h>
 #include <dirichlet/chaotic_tiled.h>
 #include <dirichlet/red_black_smtm.h>
+#include <dirichlet/red_black_smtm_df.h>
+#include <dirichlet/red_black_smtm_mc.h>
 #include <dirichlet/red_black_smtmo.h>
 #include <dirichlet/red_black_tiled.h>
+#include <dirichlet/red_black_diamond.h>
+#include <dirichlet/heat_tiled.h>
+#include <dirichlet/bicgstab.h>
+#include <dirichlet/line_zebra.h>
+#include <dirichlet/adi.h>
 #include <dirichlet/red_black_smtm_s.h>
+#include <dirichlet/jacoby_3d.h>
+#include <dirichlet/red_black_3d.h>
+#include <dirichlet/red_black_tiled_3d.h>
 
 #include <program-storage.h>
 
@@ -21,12 +34,17 @@ class JacobyBuilder : public IDirichletBuilder
 		auto [systems, controls] = try_get_dirichlet_parts(root);
 
 		if (config.contains("/dirichlet/jacoby"_json_pointer)) {
+			auto& shaderConfig = try_get_value(config, "/shader_storage/shaders/jacoby.comp"_json_pointer);
+			int channels = get_grid_channels(shaderConfig);
+			std::string prog = (subgroup_compatible(shaderConfig) && use_subgroup_programs(programStorage, {"jacoby_subgroup"}) ? "jacoby_subgroup" : "jacoby");
 			return create_one_shader_sys<dir2d::Jacoby>(*systems,
 													 *controls,
 													 programStorage,
 													 config,
 													 "jacoby",
-													 "jacoby");
+													 prog,
+													 get_residual_program(programStorage),
+													 channels);
 		}
 		return {};
 	}
@@ -34,6 +52,27 @@ class JacobyBuilder : public IDirichletBuilder
 
 REGISTER_DIRICHLET_BUILDER(jacoby, JacobyBuilder);
 
+class JacobyStreamBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/jacoby_stream"_json_pointer)) {
+			return create_one_shader_sys<dir2d::Jacoby>(*systems,
+													 *controls,
+													 programStorage,
+													 config,
+													 "jacoby_stream",
+													 "jacoby_stream");
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(jacoby_stream, JacobyStreamBuilder);
+
 class RedBlackBuilder : public IDirichletBuilder
 {
 	ModulePtr build(Module& root, const json& config) override
@@ -42,12 +81,17 @@ class RedBlackBuilder : public IDirichletBuilder
 		auto [systems, controls] = try_get_dirichlet_parts(root);
 
 		if (config.contains("/dirichlet/red_black"_json_pointer)) {
+			auto& shaderConfig = try_get_value(config, "/shader_storage/shaders/red_black.comp"_json_pointer);
+			int channels = get_grid_channels(shaderConfig);
+			std::string prog = (subgroup_compatible(shaderConfig) && use_subgroup_programs(programStorage, {"red_black_subgroup"}) ? "red_black_subgroup" : "red_black");
 			return create_one_shader_sys<dir2d::RedBlack>(*systems,
 														*controls,
 														programStorage,
 														config,
 														"red_black",
-														"red_black");
+														prog,
+														get_residual_program(programStorage),
+														channels);
 		}
 		return {};
 	}
@@ -55,6 +99,155 @@ class RedBlackBuilder : public IDirichletBuilder
 
 REGISTER_DIRICHLET_BUILDER(red_black, RedBlackBuilder);
 
+class RedBlackStreamBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/red_black_stream"_json_pointer)) {
+			return create_one_shader_sys<dir2d::RedBlack>(*systems,
+														*controls,
+														programStorage,
+														config,
+														"red_black_stream",
+														"red_black_stream");
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(red_black_stream, RedBlackStreamBuilder);
+
+class RedBlackPersistentBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/red_black_persistent"_json_pointer)) {
+			return create_one_shader_sys<dir2d::RedBlackPersistent>(*systems,
+																	*controls,
+																	programStorage,
+																	config,
+																	"red_black_persistent",
+																	"red_black_persistent");
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(red_black_persistent, RedBlackPersistentBuilder);
+
+class JacobyCoarseBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/jacoby_coarse"_json_pointer)) {
+			return create_one_shader_sys<dir2d::Jacoby>(*systems,
+													 *controls,
+													 programStorage,
+													 config,
+													 "jacoby_coarse",
+													 "jacoby_coarse");
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(jacoby_coarse, JacobyCoarseBuilder);
+
+class JacobyTiledBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/jacoby_tiled"_json_pointer)) {
+			return create_one_shader_sys<dir2d::Jacoby>(*systems,
+													 *controls,
+													 programStorage,
+													 config,
+													 "jacoby_tiled",
+													 "jacoby_tiled",
+													 get_residual_program(programStorage));
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(jacoby_tiled, JacobyTiledBuilder);
+
+class JacobyTiledStridedBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/jacoby_tiled_strided"_json_pointer)) {
+			return create_one_shader_sys<dir2d::Jacoby>(*systems,
+													 *controls,
+													 programStorage,
+													 config,
+													 "jacoby_tiled_strided",
+													 "jacoby_tiled_strided");
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(jacoby_tiled_strided, JacobyTiledStridedBuilder);
+
+class JacobySmtmBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/jacoby_smtm"_json_pointer)) {
+			return create_two_shader_sys<dir2d::JacobySmtm>(*systems,
+															*controls,
+															programStorage,
+															config,
+															"jacoby_smtm",
+															"jacoby_smtm_st0",
+															"jacoby_smtm_st1");
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(jacoby_smtm, JacobySmtmBuilder);
+
+class RedBlackCoarseBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/red_black_coarse"_json_pointer)) {
+			return create_one_shader_sys<dir2d::RedBlack>(*systems,
+														*controls,
+														programStorage,
+														config,
+														"red_black_coarse",
+														"red_black_coarse");
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(red_black_coarse, RedBlackCoarseBuilder);
+
 class RedBlackTiledBuilder : public IDirichletBuilder
 {
 	ModulePtr build(Module& root, const json& config) override
@@ -68,7 +261,8 @@ class RedBlackTiledBuilder : public IDirichletBuilder
 															   programStorage,
 															   config,
 															   "red_black_tiled",
-															   "red_black_tiled");
+															   "red_black_tiled",
+															   get_residual_program(programStorage));
 		}
 		return {};
 	}
@@ -76,6 +270,48 @@ class RedBlackTiledBuilder : public IDirichletBuilder
 
 REGISTER_DIRICHLET_BUILDER(red_black_tiled, RedBlackTiledBuilder);
 
+class RedBlackTiledStridedBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/red_black_tiled_strided"_json_pointer)) {
+			return create_one_shader_sys<dir2d::RedBlackTiled>(*systems,
+															   *controls,
+															   programStorage,
+															   config,
+															   "red_black_tiled_strided",
+															   "red_black_tiled_strided");
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(red_black_tiled_strided, RedBlackTiledStridedBuilder);
+
+class RedBlackDiamondBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/red_black_diamond"_json_pointer)) {
+			return create_one_shader_sys<dir2d::RedBlackDiamond>(*systems,
+																 *controls,
+																 programStorage,
+																 config,
+																 "red_black_diamond",
+																 "red_black_diamond");
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(red_black_diamond, RedBlackDiamondBuilder);
+
 class RedBlackSmtmBuilder : public IDirichletBuilder
 {
 	ModulePtr build(Module& root, const json& config) override
@@ -85,13 +321,26 @@ class RedBlackSmtmBuilder : public IDirichletBuilder
 
 		if (config.contains("/dirichlet/red_black_smtm"_json_pointer))
 		{
+			auto& shaderConfig = try_get_value(config, "/shader_storage/shaders/red_black_smtm_st0.comp"_json_pointer);
+			bool subgroup = subgroup_compatible(shaderConfig) && use_subgroup_programs(programStorage, {"red_black_smtm_subgroup_st0", "red_black_smtm_subgroup_st1"});
+			std::string progSt0 = (subgroup ? "red_black_smtm_subgroup_st0" : "red_black_smtm_st0");
+			std::string progSt1 = (subgroup ? "red_black_smtm_subgroup_st1" : "red_black_smtm_st1");
+
+			// both stages address the same grids
+			int ghost = get_storage_ghost(try_get_value(config, json::json_pointer("/shader_storage/shaders/" + progSt0 + ".comp")));
+			if (ghost != get_storage_ghost(try_get_value(config, json::json_pointer("/shader_storage/shaders/" + progSt1 + ".comp"))))
+			{
+				throw std::runtime_error("Invalid ghost layers specified: they must be equal in both programs.");
+			}
+
 			return create_two_shader_sys<dir2d::RedBlackTiledSmtm>(*systems,
 																   *controls,
 																   programStorage,
 																   config,
 																   "red_black_smtm",
-																   "red_black_smtm_st0",
-																   "red_black_smtm_st1");
+																   progSt0,
+																   progSt1,
+																   ghost);
 		}
 		return {};
 	}
@@ -99,6 +348,50 @@ class RedBlackSmtmBuilder : public IDirichletBuilder
 
 REGISTER_DIRICHLET_BUILDER(red_black_smtm, RedBlackSmtmBuilder);
 
+class RedBlackSmtmDfBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/red_black_smtm_df"_json_pointer)) {
+			return create_one_shader_sys<dir2d::RedBlackTiledSmtmDf>(*systems,
+																	 *controls,
+																	 programStorage,
+																	 config,
+																	 "red_black_smtm_df",
+																	 "red_black_smtm_df");
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(red_black_smtm_df, RedBlackSmtmDfBuilder);
+
+class RedBlackSmtmMcBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/red_black_smtm_mc"_json_pointer)) {
+			uint colours = get_colours(try_get_value(config, "/shader_storage/shaders/red_black_smtm_mc.comp"_json_pointer));
+			return create_one_shader_sys<dir2d::RedBlackSmtmMc>(*systems,
+																*controls,
+																programStorage,
+																config,
+																"red_black_smtm_mc",
+																"red_black_smtm_mc",
+																colours);
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(red_black_smtm_mc, RedBlackSmtmMcBuilder);
+
 class RedBlackSmtmSBuilder : public IDirichletBuilder
 {
 	ModulePtr build(Module& root, const json& config) override
@@ -172,16 +465,240 @@ class ChaoticSmtmBuilder : public IDirichletBuilder
 		auto [systems, controls] = try_get_dirichlet_parts(root);
 
 		if (config.contains("/dirichlet/chaotic_smtm"_json_pointer)) {
+			auto& shaderConfig = try_get_value(config, "/shader_storage/shaders/chaotic_smtm_st0.comp"_json_pointer);
+			bool subgroup = subgroup_compatible(shaderConfig) && use_subgroup_programs(programStorage, {"chaotic_smtm_subgroup_st0", "chaotic_smtm_subgroup_st1"});
 			return create_two_shader_sys<dir2d::ChaoticSmtm>(*systems,
 															 *controls,
 															 programStorage,
 															 config,
 															 "chaotic_smtm",
-															 "chaotic_smtm_st0",
-															 "chaotic_smtm_st1");
+															 (subgroup ? "chaotic_smtm_subgroup_st0" : "chaotic_smtm_st0"),
+															 (subgroup ? "chaotic_smtm_subgroup_st1" : "chaotic_smtm_st1"));
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(chaotic_smtm, ChaoticSmtmBuilder);
+
+class ChaoticSmtmDfBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/chaotic_smtm_df"_json_pointer)) {
+			return create_one_shader_sys<dir2d::ChaoticSmtmDf>(*systems,
+															   *controls,
+															   programStorage,
+															   config,
+															   "chaotic_smtm_df",
+															   "chaotic_smtm_df");
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(chaotic_smtm_df, ChaoticSmtmDfBuilder);
+
+class JacobyMehrstellenBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/jacoby_mehrstellen"_json_pointer)) {
+			return create_one_shader_sys<dir2d::Jacoby>(*systems,
+													 *controls,
+													 programStorage,
+													 config,
+													 "jacoby_mehrstellen",
+													 "jacoby_mehrstellen",
+													 get_residual_program(programStorage));
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(jacoby_mehrstellen, JacobyMehrstellenBuilder);
+
+// 9-point stencil couples diagonal neighbours, so four colours are swept instead of two
+class RedBlackMehrstellenBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/red_black_mehrstellen"_json_pointer)) {
+			return create_one_shader_sys<dir2d::RedBlack>(*systems,
+														*controls,
+														programStorage,
+														config,
+														"red_black_mehrstellen",
+														"red_black_mehrstellen",
+														get_residual_program(programStorage),
+														1,
+														4);
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(red_black_mehrstellen, RedBlackMehrstellenBuilder);
+
+class HeatTiledBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/heat_tiled"_json_pointer)) {
+			return create_one_shader_sys<dir2d::HeatTiled>(*systems,
+														 *controls,
+														 programStorage,
+														 config,
+														 "heat_tiled",
+														 "heat_tiled",
+														 get_residual_program(programStorage));
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(heat_tiled, HeatTiledBuilder);
+
+class BiCGStabBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/bicgstab"_json_pointer)) {
+			return create_one_shader_sys<dir2d::BiCGStab>(*systems,
+														*controls,
+														programStorage,
+														config,
+														"bicgstab",
+														"bicgstab",
+														get_shader_program(programStorage, "bicgstab_reduce"));
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(bicgstab, BiCGStabBuilder);
+
+class LineZebraBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/line_zebra"_json_pointer)) {
+			return create_one_shader_sys<dir2d::LineZebra>(*systems,
+														*controls,
+														programStorage,
+														config,
+														"line_zebra",
+														"line_zebra",
+														get_residual_program(programStorage));
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(line_zebra, LineZebraBuilder);
+
+class AdiBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/adi"_json_pointer)) {
+			return create_one_shader_sys<dir2d::Adi>(*systems,
+														*controls,
+														programStorage,
+														config,
+														"adi",
+														"adi",
+														get_residual_program(programStorage));
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(adi, AdiBuilder);
+
+class Jacoby3DBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/jacoby_3d"_json_pointer)) {
+			return create_volume_sys<dir3d::Jacoby>(*systems,
+													*controls,
+													programStorage,
+													config,
+													"jacoby_3d",
+													"jacoby_3d",
+													get_residual_program(programStorage));
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(jacoby_3d, Jacoby3DBuilder);
+
+class RedBlack3DBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/red_black_3d"_json_pointer)) {
+			return create_volume_sys<dir3d::RedBlack>(*systems,
+													  *controls,
+													  programStorage,
+													  config,
+													  "red_black_3d",
+													  "red_black_3d",
+													  get_residual_program(programStorage));
+		}
+		return {};
+	}
+};
+
+REGISTER_DIRICHLET_BUILDER(red_black_3d, RedBlack3DBuilder);
+
+class RedBlackTiled3DBuilder : public IDirichletBuilder
+{
+	ModulePtr build(Module& root, const json& config) override
+	{
+		auto& programStorage = try_get_module_data<ProgramStorage>(root, "program_storage");
+		auto [systems, controls] = try_get_dirichlet_parts(root);
+
+		if (config.contains("/dirichlet/red_black_tiled_3d"_json_pointer)) {
+			return create_volume_sys<dir3d::RedBlackTiled>(*systems,
+														   *controls,
+														   programStorage,
+														   config,
+														   "red_black_tiled_3d",
+														   "red_black_tiled_3d",
+														   get_residual_program(programStorage));
 		}
 		return {};
 	}
 };
 
-REGISTER_DIRICHLET_BUILDER(chaotic_smtm, ChaoticSmtmBuilder);
\ No newline at end of file
+REGISTER_DIRICHLET_BUILDER(red_black_tiled_3d, RedBlackTiled3DBuilder);
\ No newline at end of file
@@ -0,0 +1,19 @@
+// shared definitions of bicgstab.comp and bicgstab_reduce.comp, must match BiCGStab system
+// every stage of bicgstab.comp writes one vec2 partial of its dot products per workgroup,
+// bicgstab_reduce.comp sums the partials of the stage and updates the scalars of the method
+// scalars stay on gpu, so an iteration has no readbacks
+
+// stages of an iteration are V, T, X, P
+#define BICGSTAB_INIT 0 // r = f - Ax, rh = r, p = r;                    partials (r * r, r * r)
+#define BICGSTAB_V 1    // v = Ap;                                       partials (rh * v, 0)
+#define BICGSTAB_T 2    // s = r - alpha v, t = As;                      partials (t * s, t * t)
+#define BICGSTAB_X 3    // x += alpha p + omega s, r = s - omega t;      partials (rh * r, r * r)
+#define BICGSTAB_P 4    // p = r + beta (p - omega v);                   no partials
+
+#define BICGSTAB_PARTIALS_BINDING 8
+#define BICGSTAB_SCALARS_BINDING 9
+
+#define BICGSTAB_PARTIALS_BLOCK layout(std430, binding = BICGSTAB_PARTIALS_BINDING) restrict buffer PartialsBlock { vec2 partials[]; } bicgstabPartials
+
+// residual is the 2-norm of f - Ax
+#define BICGSTAB_SCALARS_BLOCK layout(std430, binding = BICGSTAB_SCALARS_BINDING) restrict buffer ScalarsBlock { float rho; float alpha; float omega; float beta; float residual; } bicgstabScalars
@@ -0,0 +1,94 @@
+// boundary conditions of the edges of the box(_BOUNDARY), default is dirichlet on all edges
+// types mirror dir2d::BoundaryType, edges are left(x = 0), right(x = size.x - 1), bottom(y = 0), top(y = size.y - 1)
+//     dirichlet - edge points keep their values
+//     neumann   - du/dn = g
+//     robin     - du/dn + a * u = g
+// points of neumann and robin edges are unknowns updated by the same sweep as the inner points
+// missing neighbour of such a point is a ghost cell mirrored over the edge: u(-1) = u(1) - 2h * (a * u(0) - g),
+// ghosts aren't stored, they are mirrored from the loaded neighbours right before the update, so no extra pass is required
+// flux g is folded into f of the edge points by the data(see DataAabb2D::set_boundary), analytic rhs has g = 0
+// robin term a * u(0) is moved to the diagonal, so the update stays implicit(lagged term breaks convergence of jacoby)
+// must be included after grid.glsl
+// usage:
+//     boundaryUpdatedX(global, size) - point is an unknown along x: inner point or point of a non-dirichlet x edge
+//     boundaryUpdatedY(global, size) - the same along y
+//     boundaryUpdated(global, size)  - point is an unknown, inner points only without _BOUNDARY
+//     boundaryGhosts(global, size, um10, u10, u0m1, u01) - replaces neighbours out of the grid with ghosts
+//     boundaryRobin(global, size, hx, hy)                - sum of 2a/h of robin edges of the point, subtracted from the diagonal
+
+#define BOUNDARY_DIRICHLET 0
+#define BOUNDARY_NEUMANN 1
+#define BOUNDARY_ROBIN 2
+
+#define BOUNDARY_LEFT 0
+#define BOUNDARY_RIGHT 1
+#define BOUNDARY_BOTTOM 2
+#define BOUNDARY_TOP 3
+
+#ifdef _BOUNDARY
+	#ifdef _COEF
+		#error "Neumann and Robin edges require constant coefficient."
+	#endif
+
+	uniform ivec4 boundaryType;   // left, right, bottom, top
+	uniform vec4 boundaryRobinA; // a of robin edges, zero for the others
+
+	bool boundaryUpdatedX(ivec2 global, ivec2 size)
+	{
+		return (0 < global.x && global.x < size.x - 1)
+			|| (global.x == 0 && boundaryType[BOUNDARY_LEFT] != BOUNDARY_DIRICHLET)
+			|| (global.x == size.x - 1 && boundaryType[BOUNDARY_RIGHT] != BOUNDARY_DIRICHLET);
+	}
+
+	bool boundaryUpdatedY(ivec2 global, ivec2 size)
+	{
+		return (0 < global.y && global.y < size.y - 1)
+			|| (global.y == 0 && boundaryType[BOUNDARY_BOTTOM] != BOUNDARY_DIRICHLET)
+			|| (global.y == size.y - 1 && boundaryType[BOUNDARY_TOP] != BOUNDARY_DIRICHLET);
+	}
+
+	// ghosts of dirichlet edges are never used: their points aren't updated
+	void boundaryGhosts(ivec2 global, ivec2 size, inout grid_t um10, inout grid_t u10, inout grid_t u0m1, inout grid_t u01)
+	{
+		if (global.x == 0) {
+			um10 = u10;
+		}
+		if (global.x == size.x - 1) {
+			u10 = um10;
+		}
+		if (global.y == 0) {
+			u0m1 = u01;
+		}
+		if (global.y == size.y - 1) {
+			u01 = u0m1;
+		}
+	}
+
+	float boundaryRobin(ivec2 global, ivec2 size, float hx, float hy)
+	{
+		float robin = 0.0;
+		if (global.x == 0) {
+			robin += 2.0 * boundaryRobinA[BOUNDARY_LEFT] / hx;
+		}
+		if (global.x == size.x - 1) {
+			robin += 2.0 * boundaryRobinA[BOUNDARY_RIGHT] / hx;
+		}
+		if (global.y == 0) {
+			robin += 2.0 * boundaryRobinA[BOUNDARY_BOTTOM] / hy;
+		}
+		if (global.y == size.y - 1) {
+			robin += 2.0 * boundaryRobinA[BOUNDARY_TOP] / hy;
+		}
+		return robin;
+	}
+#else
+	#define boundaryUpdatedX(global, size) (0 < (global).x && (global).x < (size).x - 1)
+	#define boundaryUpdatedY(global, size) (0 < (global).y && (global).y < (size).y - 1)
+	#define boundaryGhosts(global, size, um10, u10, u0m1, u01)
+	#define boundaryRobin(global, size, hx, hy) 0.0
+#endif
+
+bool boundaryUpdated(ivec2 global, ivec2 size)
+{
+	return boundaryUpdatedX(global, size) && boundaryUpdatedY(global, size);
+}
@@ -0,0 +1,47 @@
+// shared memory layout of the cache, cells are zero-based: [0, CACHE_X) x [0, CACHE_Y)
+// must be included after CACHE_X, CACHE_Y and CACHE_SIZE are defined
+//     column major - x * CACHE_Y + y(default), lanes along x are CACHE_Y floats apart
+//     row major    - y * CACHE_X + x
+//     padded       - column major with odd stride, lanes along x hit different banks
+//     xor          - column major, bank bits of the index are xor-ed with the index of the row of banks
+// declaration:
+//     shared float cache[CACHE_ALLOC];
+// access:
+//     cache[cacheLayoutIndex(cell)]
+
+#define CACHE_LAYOUT_COLUMN_MAJOR 0
+#define CACHE_LAYOUT_ROW_MAJOR 1
+#define CACHE_LAYOUT_PADDED 2
+#define CACHE_LAYOUT_XOR 3
+
+#ifndef _CACHE_LAYOUT
+	#define _CACHE_LAYOUT CACHE_LAYOUT_COLUMN_MAJOR
+#endif
+
+#define CACHE_LAYOUT _CACHE_LAYOUT
+
+#define CACHE_BANKS 32
+
+#if CACHE_LAYOUT == CACHE_LAYOUT_PADDED
+	#define CACHE_STRIDE (CACHE_Y | 1)
+	#define CACHE_ALLOC (CACHE_X * CACHE_STRIDE)
+#elif CACHE_LAYOUT == CACHE_LAYOUT_XOR
+	// xor keeps index inside of its row of banks, the last row is allocated in full
+	#define CACHE_ALLOC ((CACHE_SIZE + CACHE_BANKS - 1) / CACHE_BANKS * CACHE_BANKS)
+#else
+	#define CACHE_ALLOC CACHE_SIZE
+#endif
+
+int cacheLayoutIndex(ivec2 cell)
+{
+#if CACHE_LAYOUT == CACHE_LAYOUT_ROW_MAJOR
+	return cell.y * CACHE_X + cell.x;
+#elif CACHE_LAYOUT == CACHE_LAYOUT_PADDED
+	return cell.x * CACHE_STRIDE + cell.y;
+#elif CACHE_LAYOUT == CACHE_LAYOUT_XOR
+	int index = cell.x * CACHE_Y + cell.y;
+	return index ^ ((index / CACHE_BANKS) % CACHE_BANKS);
+#else
+	return cell.x * CACHE_Y + cell.y;
+#endif
+}
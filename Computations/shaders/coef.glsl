@@ -0,0 +1,29 @@
+// variable coefficient k of div(k grad u) = f(_COEF), default is k = 1
+// k is point-centred, a face takes the mean of k of its two points
+// k has the same channels as the grids, so packed problems can have different coefficients
+// must be included after grid.glsl
+// declaration:
+//     COEF_GRID(binding, Block, name); - read-only grid, unused constant without _COEF
+// access:
+//     coefLoad(name, coord)            - see gridLoad, 1.0 without _COEF
+//     coefUpdate(...)                  - jacoby value of the point
+
+#ifdef _COEF
+	#define COEF_GRID(bind, block, name) READONLY_GRID(bind, block, name)
+	#define coefLoad(name, coord) gridLoad(name, coord)
+#else
+	#define COEF_GRID(bind, block, name) const int name = bind
+	#define coefLoad(name, coord) grid_t(1.0)
+#endif
+
+// the same as the constant coefficient update if k = 1
+grid_t coefUpdate(grid_t um10, grid_t u10, grid_t u0m1, grid_t u01, grid_t f00,
+				  grid_t k00, grid_t km10, grid_t k10, grid_t k0m1, grid_t k01, float hx, float hy)
+{
+	grid_t kxm = 0.5 * (km10 + k00) / (hx * hx);
+	grid_t kxp = 0.5 * (k10 + k00) / (hx * hx);
+	grid_t kym = 0.5 * (k0m1 + k00) / (hy * hy);
+	grid_t kyp = 0.5 * (k01 + k00) / (hy * hy);
+
+	return (kxm * um10 + kxp * u10 + kym * u0m1 + kyp * u01 - f00) / (kxm + kxp + kym + kyp);
+}
@@ -0,0 +1,44 @@
+// multi-colour tile scheduling, mirrors count_colour_workgroups
+// must be included after swizzle.glsl, COLOURS is defined and numWorkgroupsX, numWorkgroupsY uniforms are declared
+// 1d dispatch of all tiles of one colour:
+//     ivec2 work = getColourWorkgroupID(int(gl_WorkGroupID.x), colour);
+
+#if COLOURS == 4
+	#define COLOUR_PERIOD 2
+#elif COLOURS == 9
+	#define COLOUR_PERIOD 3
+#elif COLOURS != 2
+	#error "Unsupported number of colours."
+#endif
+
+#ifdef COLOUR_PERIOD
+	ivec2 getColourWorkgroupID(int id, int colour)
+	{
+		ivec2 first = ivec2(colour % COLOUR_PERIOD, colour / COLOUR_PERIOD);
+		ivec2 tiles;
+		tiles.x = (numWorkgroupsX - first.x + COLOUR_PERIOD - 1) / COLOUR_PERIOD;
+		tiles.y = (numWorkgroupsY - first.y + COLOUR_PERIOD - 1) / COLOUR_PERIOD;
+		return first + swizzleWorkgroupID(id, tiles) * COLOUR_PERIOD;
+	}
+
+	// colour of the tile along one axis
+	int getColourAlongAxis(int tile)
+	{
+		return tile % COLOUR_PERIOD;
+	}
+#else
+	// checkerboard, see getWorkgroupID of smtm kernels
+	ivec2 getColourWorkgroupID(int id, int colour)
+	{
+		id = swizzleStageWorkgroupID(id, numWorkgroupsX, numWorkgroupsY);
+
+		ivec2 work;
+		work.x = id % numWorkgroupsX;
+		work.y = id / numWorkgroupsX * 2;
+		if (work.y == numWorkgroupsY - 1) {
+			work.x = 2 * work.x + colour;
+		}
+		work.y += (work.x + colour) % 2;
+		return work;
+	}
+#endif
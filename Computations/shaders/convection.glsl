@@ -0,0 +1,64 @@
+// convection term of the convection-diffusion operator div(grad(u)) + b * grad(u) = f(_CONVECTION), default is the poisson problem
+// _CONVECTION selects the difference of the first derivatives:
+//     CONVECTION_CENTRAL - second order, weights of the neighbours stay positive only while |b| h / 2 <= 1(cell peclet number)
+//     CONVECTION_UPWIND  - first order, one-sided difference towards the neighbour b points to, weights are positive for any b
+// jacoby and gauss-seidel converge while weights are positive, the operator is not symmetric, so SOR parameter of the poisson
+// problem is not used and strongly convective problems are left to bicgstab
+// usage:
+//     convectionWeights(hx, hy)          - weights of (um10, u10, u0m1, u01), 1/h^2 without _CONVECTION
+//     convectionDiagonal(hx, hy)         - weight of u00, -2/hx^2 - 2/hy^2 without _CONVECTION
+//     convectionApply(u00, u, hx, hy)    - operator applied to the point, u is (um10, u10, u0m1, u01)
+
+#define CONVECTION_CENTRAL 0
+#define CONVECTION_UPWIND 1
+
+#ifdef _CONVECTION
+	#ifdef _COEF
+		#error "Convection requires constant coefficient."
+	#endif
+	#ifdef _BOUNDARY
+		#error "Convection requires dirichlet edges."
+	#endif
+	#ifdef _SHIFT
+		#error "Convection requires steady problems."
+	#endif
+
+	#define CONVECTION _CONVECTION
+
+	uniform vec2 velocity; // b
+#else
+	#define CONVECTION CONVECTION_CENTRAL
+
+	const vec2 velocity = vec2(0.0);
+#endif
+
+vec4 convectionWeights(float hx, float hy)
+{
+	vec2 h = vec2(hx, hy);
+	vec2 diffusion = 1.0 / (h * h);
+#if CONVECTION == CONVECTION_UPWIND
+	vec2 backward = max(-velocity, 0.0) / h;
+	vec2 forward  = max(velocity, 0.0) / h;
+#else
+	vec2 backward = -0.5 * velocity / h;
+	vec2 forward  = 0.5 * velocity / h;
+#endif
+	return vec4(diffusion.x + backward.x, diffusion.x + forward.x, diffusion.y + backward.y, diffusion.y + forward.y);
+}
+
+float convectionDiagonal(float hx, float hy)
+{
+	vec2 h = vec2(hx, hy);
+	vec2 diffusion = -2.0 / (h * h);
+#if CONVECTION == CONVECTION_UPWIND
+	vec2 convection = -abs(velocity) / h;
+#else
+	vec2 convection = vec2(0.0);
+#endif
+	return diffusion.x + diffusion.y + convection.x + convection.y;
+}
+
+float convectionApply(float u00, vec4 u, float hx, float hy)
+{
+	return convectionDiagonal(hx, hy) * u00 + dot(convectionWeights(hx, hy), u);
+}
@@ -0,0 +1,62 @@
+// single dispatch scheduling of two-stage smtm kernels
+// must be included after numWorkgroupsX, numWorkgroupsY uniforms are declared and DATAFLOW_BINDING is defined
+// tickets are handed out in dispatch order: all stage 0 tiles are taken before any stage 1 tile, so
+// stage 1 tile waits only for stage 0 tiles that are already running and the scheme cannot deadlock
+//     ticket = dataflowAcquireTicket();
+//     stage 0: ... dataflowPublish(work);
+//     stage 1: dataflowWait(work); ...
+
+// must be zeroed before dispatch
+layout(std430, binding = DATAFLOW_BINDING) coherent restrict buffer DataflowBlock
+{
+	uint ticket;  // next tile to take
+	uint ready[]; // per tile of the workgroup grid: 1 if stage 0 results of the tile are published
+} dataflow;
+
+shared uint dataflowTicket;
+
+int dataflowAcquireTicket()
+{
+	if (gl_LocalInvocationIndex == 0) {
+		dataflowTicket = atomicAdd(dataflow.ticket, 1u);
+	}
+	barrier();
+	return int(dataflowTicket);
+}
+
+bool dataflowHasTile(ivec2 work)
+{
+	return all(lessThanEqual(ivec2(0), work)) && all(lessThan(work, ivec2(numWorkgroupsX, numWorkgroupsY)));
+}
+
+int dataflowTileIndex(ivec2 work)
+{
+	return work.y * numWorkgroupsX + work.x;
+}
+
+// all writes of the workgroup become visible before the flag is raised
+void dataflowPublish(ivec2 work)
+{
+	memoryBarrier();
+	barrier();
+	if (gl_LocalInvocationIndex == 0) {
+		atomicExchange(dataflow.ready[dataflowTileIndex(work)], 1u);
+	}
+}
+
+// waits for four neighbours(all of them are stage 0 tiles) to publish their halos
+void dataflowWait(ivec2 work)
+{
+	const ivec2 neighbours[4] = {ivec2(-1, 0), ivec2(1, 0), ivec2(0, -1), ivec2(0, 1)};
+
+	if (gl_LocalInvocationIndex == 0) {
+		for (int i = 0; i < 4; i++) {
+			ivec2 neighbour = work + neighbours[i];
+			if (dataflowHasTile(neighbour)) {
+				while (atomicAdd(dataflow.ready[dataflowTileIndex(neighbour)], 0u) == 0u) {}
+			}
+		}
+	}
+	barrier();
+	memoryBarrier();
+}
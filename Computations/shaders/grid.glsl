@@ -0,0 +1,94 @@
+// grid access, either r32f image2D(default) or pitched std430 buffer(_STORAGE_SSBO)
+// buffer can be padded with _STORAGE_GHOST ghost layers on each side, size is aligned to tiles then(see GridStorage)
+// _GRID_CHANNELS 4 packs independent problems into rgba32f channels, values are vec4 then(see DataAabb2D::pack_data)
+// value type:
+//     grid_t                               - float or vec4, scalar arithmetic applies to all channels
+//     gridMaxAbs(value)                    - max of absolute values over channels
+// declaration:
+//     GRID(binding, Block, name);          - read-write grid, Block is a name of the buffer block(unused by images)
+//     READONLY_GRID(binding, Block, name); - read-only grid
+//     GRID(binding, Block, name)[2];       - array of grids
+//     COHERENT_GRID(binding, Block, name); - read-write grid, writes are visible to other workgroups after memoryBarrier()
+// access:
+//     gridLoad(name, coord)                - returns zero if out of bounds
+//     gridStore(name, coord, value)        - out of bounds writes are ignored
+//     gridLoadFast(name, coord)            - no bounds check, coord must stay inside of the storage
+//     gridStoreFast(name, coord, value)    - no bounds check, coord must stay inside of the storage
+//     gridSize(name)                       - size of the grid(all grids of a program have the same size)
+
+#ifndef _GRID_CHANNELS
+	#define _GRID_CHANNELS 1
+#endif
+
+#define GRID_CHANNELS _GRID_CHANNELS
+
+#if GRID_CHANNELS == 1
+	#define grid_t float
+	#define GRID_COMPONENTS x
+	#ifndef FMT
+		#define FMT r32f
+	#endif
+#elif GRID_CHANNELS == 4
+	#define grid_t vec4
+	#define GRID_COMPONENTS xyzw
+	#ifndef FMT
+		#define FMT rgba32f
+	#endif
+#else
+	#error "Grid must have 1 or 4 channels."
+#endif
+
+float gridMaxAbs(float value)
+{
+	return abs(value);
+}
+
+float gridMaxAbs(vec4 value)
+{
+	vec4 a = abs(value);
+	return max(max(a.x, a.y), max(a.z, a.w));
+}
+
+#ifdef _STORAGE_SSBO
+	uniform ivec2 gridExtent;
+	uniform int gridPitch;
+
+	#ifdef _STORAGE_GHOST
+		#define GRID_GHOST _STORAGE_GHOST
+	#else
+		#define GRID_GHOST 0
+	#endif
+
+	#define GRID(bind, block, name) layout(std430, binding = bind) restrict buffer block { grid_t data[]; } name
+	#define READONLY_GRID(bind, block, name) layout(std430, binding = bind) restrict readonly buffer block { grid_t data[]; } name
+	#define COHERENT_GRID(bind, block, name) layout(std430, binding = bind) coherent restrict buffer block { grid_t data[]; } name
+
+	bool gridInBounds(ivec2 coord)
+	{
+		return all(lessThanEqual(ivec2(0), coord)) && all(lessThan(coord, gridExtent));
+	}
+
+	int gridIndex(ivec2 coord)
+	{
+		return (coord.y + GRID_GHOST) * gridPitch + coord.x + GRID_GHOST;
+	}
+
+	#define gridLoad(name, coord) (gridInBounds(coord) ? name.data[gridIndex(coord)] : grid_t(0.0))
+	#define gridStore(name, coord, value) if (gridInBounds(coord)) { name.data[gridIndex(coord)] = (value); }
+	#define gridLoadFast(name, coord) (name.data[gridIndex(coord)])
+	#define gridStoreFast(name, coord, value) name.data[gridIndex(coord)] = (value)
+	#define gridSize(name) (gridExtent)
+#else
+	#define GRID(bind, block, name) layout(binding = bind, FMT) uniform restrict image2D name
+	#define READONLY_GRID(bind, block, name) layout(binding = bind, FMT) uniform restrict readonly image2D name
+	#define COHERENT_GRID(bind, block, name) layout(binding = bind, FMT) uniform coherent restrict image2D name
+
+	// images are not padded, out of bounds accesses are handled by hardware
+	#define GRID_GHOST 0
+
+	#define gridLoad(name, coord) (imageLoad(name, coord).GRID_COMPONENTS)
+	#define gridStore(name, coord, value) imageStore(name, coord, vec4(value))
+	#define gridLoadFast(name, coord) gridLoad(name, coord)
+	#define gridStoreFast(name, coord, value) gridStore(name, coord, value)
+	#define gridSize(name) (imageSize(name))
+#endif
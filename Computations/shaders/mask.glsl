@@ -0,0 +1,33 @@
+// masked domains(_MASK): per-point cell types and the list of tiles having interior points
+// cell types mirror dir2d::CellType, only interior points are updated
+// tiles without interior points are not dispatched: dispatch is 1d over the tile list(see MaskStorage)
+// must be included after swizzle.glsl
+// usage:
+//     ivec2 work = getMaskedWorkgroupID(); - instead of getSwizzledWorkgroupID(), the same without _MASK
+//     cellUpdated(coord)                   - false for points keeping their values, always true without _MASK
+
+#define MASK_BINDING 5
+#define MASK_TILES_BINDING 6
+
+#define CELL_INTERIOR 0u
+#define CELL_DIRICHLET 1u
+#define CELL_OUTSIDE 2u
+
+#ifdef _MASK
+	layout(binding = MASK_BINDING, r8ui) uniform restrict readonly uimage2D cellMask;
+
+	layout(std430, binding = MASK_TILES_BINDING) restrict readonly buffer MaskTilesBlock { ivec2 tiles[]; } maskTiles;
+
+	bool cellUpdated(ivec2 coord)
+	{
+		return imageLoad(cellMask, coord).x == CELL_INTERIOR;
+	}
+
+	ivec2 getMaskedWorkgroupID()
+	{
+		return maskTiles.tiles[gl_WorkGroupID.x];
+	}
+#else
+	#define cellUpdated(coord) true
+	#define getMaskedWorkgroupID() getSwizzledWorkgroupID()
+#endif
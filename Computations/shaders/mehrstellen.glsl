@@ -0,0 +1,28 @@
+// compact fourth order 9-point laplacian(mehrstellen), hx and hy can differ
+//     dxx u / hx^2 + dyy u / hy^2 + (hx^2 + hy^2) / 12 * dxx dyy u / (hx^2 * hy^2) = f + (dxx f + dyy f) / 12
+// dxx, dyy - second differences, dxx dyy u couples the diagonal neighbours
+// rhs correction is the 5-point stencil of f computed in-kernel, f must be defined on the edges of the box too
+// must be included after grid.glsl
+// usage:
+//     mehrstellenRhs(f00, fm10, f10, f0m1, f01)                   - corrected rhs of the point
+//     mehrstellenUpdate(edgesX, edgesY, corners, rhs, hx, hy)     - jacoby value of the point
+//         edgesX  - um10 + u10
+//         edgesY  - u0m1 + u01
+//         corners - um1m1 + u1m1 + um11 + u11
+
+grid_t mehrstellenRhs(grid_t f00, grid_t fm10, grid_t f10, grid_t f0m1, grid_t f01)
+{
+	return f00 + (fm10 + f10 + f0m1 + f01 - 4.0 * f00) / 12.0;
+}
+
+grid_t mehrstellenUpdate(grid_t edgesX, grid_t edgesY, grid_t corners, grid_t rhs, float hx, float hy)
+{
+	float hxhx = hx * hx;
+	float hyhy = hy * hy;
+	float c = (hxhx + hyhy) / (12.0 * hxhx * hyhy); // weight of the corners
+	float ax = 1.0 / hxhx - 2.0 * c;
+	float ay = 1.0 / hyhy - 2.0 * c;
+	float H = -2.0 / hxhx - 2.0 / hyhy + 4.0 * c;
+
+	return (rhs - ax * edgesX - ay * edgesY - c * corners) / H;
+}
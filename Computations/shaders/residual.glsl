@@ -0,0 +1,47 @@
+// fused convergence metric: max |u_new - u_old| over points stored by a dispatch(_RESIDUAL)
+// multi-step programs measure the change made by all of their steps
+// each workgroup accumulates its partial in shared memory and merges it into its slot of the partials buffer,
+// partials are reduced by residual_reduce.comp(see ResidualStorage)
+// usage(all calls are no-op without _RESIDUAL):
+//     residualInit();             - at the start of main, uniform control flow
+//     residualAccumulate(delta);  - any invocation, any number of times
+//     residualFlush();            - at the end of main, uniform control flow
+
+#define RESIDUAL_BINDING 7
+
+// non-negative floats are stored as uints: their bits are ordered the same way, so atomicMax can be used
+#define RESIDUAL_BLOCK layout(std430, binding = RESIDUAL_BINDING) restrict buffer ResidualBlock { uint partials[]; } residual
+
+#ifdef _RESIDUAL
+	RESIDUAL_BLOCK;
+
+	shared uint residualPartial;
+
+	void residualInit()
+	{
+		if (gl_LocalInvocationIndex == 0) {
+			residualPartial = 0u;
+		}
+		barrier();
+	}
+
+	void residualAccumulate(float delta)
+	{
+		atomicMax(residualPartial, floatBitsToUint(abs(delta)));
+	}
+
+	// slots are merged with atomics, so several dispatches can write the same buffer without barriers in between
+	// slot is the flat id of the workgroup, z is 0 for 2d dispatches
+	void residualFlush()
+	{
+		barrier();
+		if (gl_LocalInvocationIndex == 0) {
+			uint index = (gl_WorkGroupID.z * gl_NumWorkGroups.y + gl_WorkGroupID.y) * gl_NumWorkGroups.x + gl_WorkGroupID.x;
+			atomicMax(residual.partials[index], residualPartial);
+		}
+	}
+#else
+	#define residualInit()
+	#define residualAccumulate(delta)
+	#define residualFlush()
+#endif
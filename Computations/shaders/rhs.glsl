@@ -0,0 +1,30 @@
+// right hand side f of the equation, either a grid(default) or an analytic expression(_RHS_EXPR)
+// _RHS_EXPR is a glsl expression of float x and float y, e.g. 4.0 * (x * x + y * y - 1.0) * exp(-(x * x + y * y))
+// analytic rhs is evaluated at rhsOrigin + coord * rhsStep, no grid is bound then(see RhsUniforms)
+// must be included after grid.glsl
+// declaration:
+//     RHS_GRID(binding, Block, name); - read-only grid, unused constant if rhs is analytic
+// access:
+//     rhsLoad(name, coord)            - see gridLoad, analytic rhs is evaluated everywhere
+//     rhsLoadFast(name, coord)        - see gridLoadFast
+
+#ifdef _RHS_EXPR
+	uniform vec2 rhsOrigin;
+	uniform vec2 rhsStep;
+
+	float rhsFunction(ivec2 coord)
+	{
+		vec2 p = rhsOrigin + vec2(coord) * rhsStep;
+		float x = p.x;
+		float y = p.y;
+		return _RHS_EXPR;
+	}
+
+	#define RHS_GRID(bind, block, name) const int name = bind
+	#define rhsLoad(name, coord) rhsFunction(coord)
+	#define rhsLoadFast(name, coord) rhsFunction(coord)
+#else
+	#define RHS_GRID(bind, block, name) READONLY_GRID(bind, block, name)
+	#define rhsLoad(name, coord) gridLoad(name, coord)
+	#define rhsLoadFast(name, coord) gridLoadFast(name, coord)
+#endif
@@ -0,0 +1,17 @@
+// shift of the helmholtz operator div(grad(u)) - shift * u = f(_SHIFT), default is the poisson problem
+// implicit time steps of the heat equation are such problems: shift = 1/dt for backward euler, 2/dt for crank-nicolson
+// shift is moved to the diagonal together with robin terms, so the sweep is the same
+// usage:
+//     shiftDiagonal() - subtracted from the diagonal, 0.0 without _SHIFT
+
+#ifdef _SHIFT
+	#ifdef _COEF
+		#error "Shift requires constant coefficient."
+	#endif
+
+	uniform float shift;
+
+	#define shiftDiagonal() shift
+#else
+	#define shiftDiagonal() 0.0
+#endif
@@ -0,0 +1,62 @@
+// halo exchange between neighbouring invocations through subgroup shuffles
+// requires GL_KHR_shader_subgroup_basic and GL_KHR_shader_subgroup_shuffle to be enabled by the including shader
+// and must be included after the workgroup size and cacheLoadValue are declared
+// subgroups are expected to cover contiguous ranges of gl_LocalInvocationIndex(true for all known vendors),
+// values of neighbours from other subgroups still go through shared memory:
+//     if (haloPublisher()) { cacheStoreValue(...); } - only invocations having a neighbour in other subgroup
+//     haloBarrier();                                 - skipped if the whole workgroup is a single subgroup
+//     v = haloLoad(value, haloLane(offset), cacheIndices);
+
+#define HALO_WORKGROUP ivec2(gl_WorkGroupSize.xy)
+#define HALO_WORKGROUP_SIZE int(gl_WorkGroupSize.x * gl_WorkGroupSize.y)
+
+bool haloInWorkgroup(ivec2 offset)
+{
+	ivec2 p = ivec2(gl_LocalInvocationID.xy) + offset;
+	return all(lessThanEqual(ivec2(0), p)) && all(lessThan(p, HALO_WORKGROUP));
+}
+
+// lane of the invocation shifted by offset, -1 if it is out of the workgroup or belongs to other subgroup
+int haloLane(ivec2 offset)
+{
+	ivec2 p = ivec2(gl_LocalInvocationID.xy) + offset;
+	int base = int(gl_LocalInvocationIndex) - int(gl_SubgroupInvocationID);
+	int lane = p.y * HALO_WORKGROUP.x + p.x - base;
+	if (!haloInWorkgroup(offset) || lane < 0 || lane >= int(gl_SubgroupSize)) {
+		return -1;
+	}
+	return lane;
+}
+
+// true if neighbour shifted by offset exists but lives in other subgroup
+bool haloCrossesSubgroup(ivec2 offset)
+{
+	return haloInWorkgroup(offset) && haloLane(offset) == -1;
+}
+
+// true if any of four neighbours reads values of this invocation from shared memory
+bool haloPublisher()
+{
+	return haloCrossesSubgroup(ivec2(-1, 0)) || haloCrossesSubgroup(ivec2(1, 0))
+		|| haloCrossesSubgroup(ivec2(0, -1)) || haloCrossesSubgroup(ivec2(0, 1));
+}
+
+void haloBarrier()
+{
+	if (HALO_WORKGROUP_SIZE > int(gl_SubgroupSize)) { // dynamically uniform
+		barrier();
+	}
+}
+
+// must be called in uniform control flow: all lanes take part in shuffle, returns own value if lane is -1
+float haloShuffle(float value, int lane)
+{
+	return subgroupShuffle(value, uint(lane != -1 ? lane : int(gl_SubgroupInvocationID)));
+}
+
+// cacheIndices must be valid even if the neighbour is out of the workgroup
+float haloLoad(float value, int lane, ivec2 cacheIndices)
+{
+	float shuffled = haloShuffle(value, lane);
+	return (lane != -1 ? shuffled : cacheLoadValue(cacheIndices));
+}
@@ -0,0 +1,116 @@
+// workgroup id remap for L2 locality, mirrors swizzle_workgroup
+// concurrently resident workgroups get neighbouring tiles so halos are reused from cache
+// tiles are split into blocks ordered row-major, ids are remapped inside of a block:
+//     row major - no remap
+//     morton    - z-order inside of SWIZZLE_BLOCK x SWIZZLE_BLOCK blocks
+//     hilbert   - hilbert curve inside of SWIZZLE_BLOCK x SWIZZLE_BLOCK blocks
+//     band      - row-major inside of column bands SWIZZLE_BLOCK tiles wide
+// partial blocks on the edges of the grid fall back to row-major, remap is a bijection for any grid
+// 2d dispatch:
+//     ivec2 work = getSwizzledWorkgroupID();
+
+#define SWIZZLE_ROW_MAJOR 0
+#define SWIZZLE_MORTON 1
+#define SWIZZLE_HILBERT 2
+#define SWIZZLE_BAND 3
+
+#ifndef _SWIZZLE
+	#define _SWIZZLE SWIZZLE_ROW_MAJOR
+#endif
+
+#ifndef _SWIZZLE_BLOCK
+	#define _SWIZZLE_BLOCK 8
+#endif
+
+#define SWIZZLE _SWIZZLE
+#define SWIZZLE_BLOCK _SWIZZLE_BLOCK
+
+#if (SWIZZLE == SWIZZLE_MORTON || SWIZZLE == SWIZZLE_HILBERT) && (SWIZZLE_BLOCK & (SWIZZLE_BLOCK - 1)) != 0
+	#error "Swizzle block must be a power of two."
+#endif
+
+// d - index along the curve inside of the block
+ivec2 mortonDecode(int d)
+{
+	ivec2 p = ivec2(0);
+	for (int bit = 0; (1 << bit) < SWIZZLE_BLOCK; bit++) {
+		p.x |= ((d >> (2 * bit)) & 0x1) << bit;
+		p.y |= ((d >> (2 * bit + 1)) & 0x1) << bit;
+	}
+	return p;
+}
+
+// d - index along the curve inside of the block
+ivec2 hilbertDecode(int d)
+{
+	ivec2 p = ivec2(0);
+	for (int s = 1; s < SWIZZLE_BLOCK; s *= 2) {
+		int rx = 1 & (d / 2);
+		int ry = 1 & (d ^ rx);
+		if (ry == 0) {
+			if (rx == 1) {
+				p = s - 1 - p;
+			}
+			p = p.yx;
+		}
+		p += s * ivec2(rx, ry);
+		d /= 4;
+	}
+	return p;
+}
+
+// id - linear index of the workgroup, tiles - size of the grid of tiles
+ivec2 swizzleWorkgroupID(int id, ivec2 tiles)
+{
+#if SWIZZLE == SWIZZLE_ROW_MAJOR
+	return ivec2(id % tiles.x, id / tiles.x);
+#else
+	#if SWIZZLE == SWIZZLE_BAND
+		ivec2 block = ivec2(SWIZZLE_BLOCK, tiles.y);
+	#else
+		ivec2 block = ivec2(SWIZZLE_BLOCK);
+	#endif
+
+	// all rows of blocks but the last one are full
+	int blockRow = id / (tiles.x * block.y);
+	int rowOffset = id - blockRow * tiles.x * block.y;
+	int height = min(block.y, tiles.y - blockRow * block.y);
+
+	// all blocks of the row but the last one are full
+	int blockCol = rowOffset / (block.x * height);
+	int offset = rowOffset - blockCol * block.x * height;
+	int width = min(block.x, tiles.x - blockCol * block.x);
+
+	ivec2 origin = ivec2(blockCol, blockRow) * block;
+	#if SWIZZLE == SWIZZLE_MORTON
+		if (width == block.x && height == block.y) {
+			return origin + mortonDecode(offset);
+		}
+	#elif SWIZZLE == SWIZZLE_HILBERT
+		if (width == block.x && height == block.y) {
+			return origin + hilbertDecode(offset);
+		}
+	#endif
+	return origin + ivec2(offset % width, offset / width);
+#endif
+}
+
+ivec2 getSwizzledWorkgroupID()
+{
+	ivec2 tiles = ivec2(gl_NumWorkGroups.xy);
+	return swizzleWorkgroupID(int(gl_WorkGroupID.y) * tiles.x + int(gl_WorkGroupID.x), tiles);
+}
+
+// checkerboard stages(see getWorkgroupID of smtm kernels) enumerate tiles by pairs of rows
+// pairs are remapped as a grid of tilesX x tilesY / 2 tiles, the uneven last row is kept as is
+// returns remapped linear id, the same numbering as the one getWorkgroupID expects
+int swizzleStageWorkgroupID(int id, int tilesX, int tilesY)
+{
+	ivec2 pairs = ivec2(tilesX, tilesY / 2);
+	if (id >= pairs.x * pairs.y) {
+		return id;
+	}
+
+	ivec2 pair = swizzleWorkgroupID(id, pairs);
+	return pair.y * pairs.x + pair.x;
+}
@@ -0,0 +1,66 @@
+// batched tridiagonal solves of constant coefficient lines by cyclic reduction in shared memory
+// line is a x_{i-1} + b x_i + c x_{i+1} = d_i of unknowns 1..n, boundary values are moved to d_1 and d_n by the caller
+// one workgroup solves one line, so only d is staged in shared memory(1d workgroup, uniform n),
+// coefficients of the reduction are the same for all lines, they are computed on cpu(see create_cyclic_reduction_table)
+// table(floats):
+//     [0, 3n)        - (a, c, 1 / b) of the reduced equation of unknown i at 3 * (i - 1), used by back substitution
+//     [3n, ...)      - (k1, k2) multipliers of the forward reduction in the order of elimination
+// usage:
+//     TRIDIAGONAL_TABLE_BLOCK;
+//     tridiagonal[i] = d_i for i in [1, n]; barrier(); tridiagonalSolve(n); tridiagonal[i] is x_i then
+
+#define TRIDIAGONAL_BINDING 8
+
+// max unknowns of a line, must match tridiagonal_max
+#define TRIDIAGONAL_MAX 4096
+
+#define TRIDIAGONAL_TABLE_BLOCK layout(std430, binding = TRIDIAGONAL_BINDING) restrict readonly buffer TridiagonalBlock { float data[]; } tridiagonalTable
+
+// unknowns at 1..n, zero at 0
+shared float tridiagonal[TRIDIAGONAL_MAX + 1];
+
+// neighbours past the end of the line have zero coefficients
+float tridiagonalLoad(int i, int n)
+{
+	return i <= n ? tridiagonal[i] : 0.0;
+}
+
+// uniform control flow
+void tridiagonalSolve(int n)
+{
+	int local = int(gl_LocalInvocationIndex);
+	int threads = int(gl_WorkGroupSize.x);
+
+	if (local == 0) {
+		tridiagonal[0] = 0.0;
+	}
+	barrier();
+
+	// forward reduction: equations of the multiples of 2d eliminate their neighbours at distance d
+	int offset = 3 * n;
+	for (int d = 1; 2 * d <= n; d *= 2) {
+		int count = n / (2 * d);
+		for (int m = local; m < count; m += threads) {
+			int i = 2 * d * (m + 1);
+			float k1 = tridiagonalTable.data[offset + 2 * m];
+			float k2 = tridiagonalTable.data[offset + 2 * m + 1];
+			tridiagonal[i] -= k1 * tridiagonal[i - d] + k2 * tridiagonalLoad(i + d, n);
+		}
+		offset += 2 * count;
+		barrier();
+	}
+
+	// back substitution: unknowns of the odd multiples of d, their neighbours are solved by the previous levels
+	for (int d = 1 << findMSB(n); d > 0; d /= 2) {
+		int count = (n / d + 1) / 2;
+		for (int m = local; m < count; m += threads) {
+			int j = d * (2 * m + 1);
+			int row = 3 * (j - 1);
+			float a = tridiagonalTable.data[row];
+			float c = tridiagonalTable.data[row + 1];
+			float invB = tridiagonalTable.data[row + 2];
+			tridiagonal[j] = (tridiagonal[j] - a * tridiagonal[j - d] - c * tridiagonalLoad(j + d, n)) * invB;
+		}
+		barrier();
+	}
+}
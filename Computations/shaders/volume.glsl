@@ -0,0 +1,33 @@
+// 3d grid access, r32f image3D(see VolumeStorage)
+// declaration:
+//     VOLUME(binding, name);          - read-write volume
+//     READONLY_VOLUME(binding, name); - read-only volume
+//     VOLUME(binding, name)[2];       - array of volumes
+// access:
+//     volumeLoad(name, coord)         - returns zero if out of bounds
+//     volumeStore(name, coord, value) - out of bounds writes are ignored
+//     volumeSize(name)                - size of the volume(all volumes of a program have the same size)
+
+#define VOLUME(bind, name) layout(binding = bind, r32f) uniform restrict image3D name
+#define READONLY_VOLUME(bind, name) layout(binding = bind, r32f) uniform restrict readonly image3D name
+
+// out of bounds accesses are handled by hardware
+#define volumeLoad(name, coord) (imageLoad(name, coord).x)
+#define volumeStore(name, coord, value) imageStore(name, coord, vec4(value))
+#define volumeSize(name) (imageSize(name))
+
+bool inInnerVolume(ivec3 global, ivec3 size)
+{
+	return all(lessThan(ivec3(0), global)) && all(lessThan(global, size - 1));
+}
+
+// 7-point jacoby update of div(grad(u)) = f
+float volumeUpdate(float um100, float u100, float u0m10, float u010, float u00m1, float u001, float f000, float hx, float hy, float hz)
+{
+	float hxhx = hx * hx;
+	float hyhy = hy * hy;
+	float hzhz = hz * hz;
+	float H = -2.0 / hxhx - 2.0 / hyhy - 2.0 / hzhz;
+
+	return f000 / H - (um100 + u100) / (hxhx * H) - (u0m10 + u010) / (hyhy * H) - (u00m1 + u001) / (hzhz * H);
+}